@@ -0,0 +1,67 @@
+#include <string>
+#include <iostream>
+#include <vector>
+#include <CLI/CLI.hpp>
+#include "BenchmarkInstance.h"
+#include "BenchmarkRunner.h"
+#include "ExplicitStateDfaMona.h"
+using namespace std;
+
+int main(int argc, char **argv)
+{
+
+    CLI::App app {
+        "batch-MtSyft: Solves a manifest of multi-tier best-effort synthesis instances in a single run"
+    };
+
+    std::string manifest_file, output_file = "res_batch_mtsyft.csv";
+    double timeout = 0;
+    std::size_t memory_limit = 0, workers = 0;
+
+    app.add_option("-m,--manifest", manifest_file, "File listing one instance per line as: goal_file env_file partition_file starting_player mode")->
+        required() -> check(CLI::ExistingFile);
+
+    app.add_option("-o,--output-file", output_file, "File where the table of results is written (default res_batch_mtsyft.csv)");
+
+    app.add_option("-T,--timeout", timeout, "Time limit per instance in seconds (default none)")->
+        check(CLI::NonNegativeNumber);
+
+    app.add_option("-M,--memory-limit", memory_limit, "Memory limit per instance in MB (default none)");
+
+    app.add_option("-j,--workers", workers, "Number of worker processes (default 0, i.e. instances are solved in this process)");
+
+    std::string backend = "lydia";
+    app.add_option("-b,--backend", backend, "Translation of LTLf formulas into DFAs: lydia (compositional) or mona (first-order encoding, as by ltlf2fol) (default lydia)")->
+        check(CLI::IsMember({"lydia", "mona"}));
+
+    std::string tier_games = "all";
+    app.add_option("-g,--games", tier_games, "Games solved for each tier: all, skip (no restriction and cooperative games for tiers realizable from the initial state) or frontier (also decides the realizability of the other tiers by binary search, assuming the tiers are monotone) (default all)")->
+        check(CLI::IsMember({"all", "skip", "frontier"}));
+
+    bool quiet = false;
+    app.add_flag("-q,--quiet", quiet, "Drops the output of the synthesizers and only reports one line per instance");
+
+    CLI11_PARSE(app, argc, argv);
+
+    try {
+        Syft::ExplicitStateDfaMona::set_translation_backend(
+            Syft::translation_backend_from_string(backend));
+
+        std::vector<Syft::BenchmarkInstance> instances =
+            Syft::BenchmarkRunner::read_manifest(manifest_file);
+
+        std::cout << "[batch-MtSyft] " << instances.size() << " instances read from " << manifest_file << std::endl;
+
+        Syft::BenchmarkRunner runner(timeout, memory_limit, workers, quiet);
+        runner.set_tier_solving(Syft::tier_solving_from_string(tier_games));
+        std::vector<Syft::BenchmarkResult> results = runner.run_all(instances);
+
+        Syft::BenchmarkRunner::write_results(results, output_file);
+        std::cout << "[batch-MtSyft] Results written to " << output_file << std::endl;
+    } catch (const std::exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include <string>
+#include <iostream>
+#include <vector>
+#include <CLI/CLI.hpp>
+#include "BenchmarkInstance.h"
+#include "CounterGameGenerator.h"
+#include "RobotNavigationGenerator.h"
+using namespace std;
+
+int main(int argc, char **argv)
+{
+
+    CLI::App app {
+        "benchmark-generator: Generates counter game and robot navigation instances for MtSyft"
+    };
+
+    std::string family, mode_name = "mtsyft", output_dir;
+    std::size_t size, tiers, core = 1;
+
+    app.add_option("-f,--family", family, "Benchmark family (counter or navigation)")->
+        required() -> check(CLI::IsMember({"counter", "navigation"}));
+
+    app.add_option("-n,--size", size, "Number of counter bits or of corridor rooms")->
+        required();
+
+    app.add_option("-k,--tiers", tiers, "Number of environment tiers")->
+        required();
+
+    app.add_option("-c,--core", core, "Number of add requests shared by all tiers (counter only, default 1)");
+
+    app.add_option("-m,--mode", mode_name, "Environment file layout (mtsyft, cb-mtsyft or conj-mtsyft, default mtsyft)")->
+        check(CLI::IsMember({"mtsyft", "cb-mtsyft", "conj-mtsyft"}));
+
+    app.add_option("-o,--output-dir", output_dir, "Directory where the goal, environment and partition files are written (prints to stdout if omitted)")->
+        check(CLI::ExistingDirectory);
+
+    CLI11_PARSE(app, argc, argv);
+
+    try {
+        Syft::SynthesisMode mode = Syft::synthesis_mode_from_string(mode_name);
+
+        Syft::BenchmarkInstance instance = family == "counter" ?
+            Syft::CounterGameGenerator::instance(size, core, tiers, mode) :
+            Syft::RobotNavigationGenerator::instance(size, tiers, mode);
+
+        if (output_dir.empty()) {
+            cout << "# " << instance.name << endl;
+            cout << "# goal" << endl << instance.goal << endl;
+            cout << "# environments" << endl;
+            for (const auto& env_spec : instance.environment_specs) cout << env_spec << endl;
+            cout << "# partition" << endl << instance.partition_string();
+            cout << "# starting player: " << (instance.starting_player == Syft::Player::Agent ? 1 : 0) << endl;
+        } else {
+            instance.write_to_files(output_dir);
+            cout << "[benchmark-generator] Instance " << instance.name << " written to " << output_dir
+                 << " (starting player: " << (instance.starting_player == Syft::Player::Agent ? 1 : 0) << ")" << endl;
+        }
+    } catch (const std::exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
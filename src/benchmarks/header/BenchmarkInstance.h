@@ -0,0 +1,58 @@
+#ifndef BENCHMARK_INSTANCE_H
+#define BENCHMARK_INSTANCE_H
+
+#include <string>
+#include <vector>
+
+#include "InputOutputPartition.h"
+#include "Player.h"
+#include "SynthesisMode.h"
+
+namespace Syft {
+
+/**
+ * \brief A multi-tier best-effort synthesis problem held in memory.
+ *
+ * Stores the same information as the goal, environment and partition files
+ * taken by the MtSyft executables.
+ */
+struct BenchmarkInstance {
+  std::string name;
+  std::string goal;
+  std::vector<std::string> environment_specs; // lines of the environment file
+  InputOutputPartition partition;
+  Player starting_player;
+  SynthesisMode mode;
+
+  /**
+   * \brief Returns the partition in the format of a partition file.
+   */
+  std::string partition_string() const;
+
+  /**
+   * \brief Saves the instance as goal, environment and partition files.
+   *
+   * The files are named \a name.ltlf, \a name_envs.ltlf and \a name.part,
+   * respectively, and are created inside \a directory.
+   */
+  void write_to_files(const std::string& directory) const;
+
+  /**
+   * \brief Loads an instance from goal, environment and partition files.
+   *
+   * The files are read in the same way as the MtSyft executables do: the goal
+   * is the first line of \a goal_file and every line of \a env_file is an
+   * environment specification, interpreted according to \a mode.
+   *
+   * \return An instance named \a goal_file:\a env_file.
+   */
+  static BenchmarkInstance read_from_files(const std::string& goal_file,
+                                           const std::string& env_file,
+                                           const std::string& partition_file,
+                                           Player starting_player,
+                                           SynthesisMode mode);
+};
+
+}
+
+#endif // BENCHMARK_INSTANCE_H
@@ -0,0 +1,109 @@
+#ifndef BENCHMARK_RUNNER_H
+#define BENCHMARK_RUNNER_H
+
+#include <string>
+#include <vector>
+
+#include "BenchmarkInstance.h"
+#include "TierSolver.h"
+
+namespace Syft {
+
+/**
+ * \brief The outcome of running a single benchmark instance.
+ */
+struct BenchmarkResult {
+  std::string instance;
+  SynthesisMode mode;
+  std::string status;               // done, timeout, memout or error
+  double running_time = 0.0;        // seconds
+  std::vector<double> run_times;    // ltlf2dfa, dfa2symbolic, adv games, coop games
+  std::string realizability;        // one of A, C, U per tier, separated by ';'
+  double cudd_memory = 0.0;         // MB used by the CUDD manager at the end
+  std::string message;              // error message, if any
+};
+
+/**
+ * \brief Runs batches of benchmark instances.
+ *
+ * Every instance is solved with a fresh VarMgr, and thus a fresh CUDD
+ * manager, so that instances do not share variables or cached nodes. What is
+ * reused across instances is the translation of F(true), which is done once
+ * per process (and inherited by the workers).
+ *
+ * With no workers, instances are solved one after the other in the calling
+ * process. The timeout is then a Deadline attached to the VarMgr, so a run
+ * that exceeds it stops at the next check and reports the times collected so
+ * far, and the memory limit is the one of the CUDD manager. With workers, each
+ * instance is solved in a forked child process whose address space is capped,
+ * and which is killed if it overruns the timeout anyway.
+ */
+class BenchmarkRunner {
+ private:
+
+  double timeout_;            // seconds, 0 for no timeout
+  std::size_t memory_limit_;  // MB, 0 for no limit
+  std::size_t workers_;       // 0 to run in the calling process
+  bool quiet_;
+  TierSolving tier_solving_ = TierSolving::All;
+
+  std::vector<BenchmarkResult> run_in_workers(
+      const std::vector<BenchmarkInstance>& instances) const;
+
+ public:
+
+  /**
+   * \brief Creates a runner.
+   *
+   * \param timeout Time limit in seconds for each instance (0 for none).
+   * \param memory_limit Memory limit in MB for each instance (0 for none).
+   * \param workers Number of worker processes (0 runs in this process).
+   * \param quiet Whether the progress output of the synthesizers is dropped.
+   */
+  BenchmarkRunner(double timeout,
+                  std::size_t memory_limit,
+                  std::size_t workers,
+                  bool quiet);
+
+  /**
+   * \brief Selects which games of each instance are solved (default all).
+   */
+  void set_tier_solving(TierSolving tier_solving);
+
+  /**
+   * \brief Reads a manifest of benchmark instances.
+   *
+   * Each line of the manifest describes an instance as
+   *   goal_file env_file partition_file starting_player mode
+   * where starting_player is 1 (agent) or 0 (environment) and mode is one of
+   * mtsyft, cb-mtsyft and conj-mtsyft. Empty lines and lines starting with #
+   * are ignored. Relative paths are resolved against the directory of the
+   * manifest.
+   */
+  static std::vector<BenchmarkInstance> read_manifest(
+      const std::string& manifest_file);
+
+  /**
+   * \brief Solves \a instance in the calling process.
+   *
+   * Exceptions raised while solving are reported in the status of the result
+   * rather than propagated.
+   */
+  BenchmarkResult run(const BenchmarkInstance& instance) const;
+
+  /**
+   * \brief Solves all \a instances, in the order given.
+   */
+  std::vector<BenchmarkResult> run_all(
+      const std::vector<BenchmarkInstance>& instances) const;
+
+  /**
+   * \brief Writes \a results as a CSV table with a header row.
+   */
+  static void write_results(const std::vector<BenchmarkResult>& results,
+                            const std::string& filename);
+};
+
+}
+
+#endif // BENCHMARK_RUNNER_H
@@ -0,0 +1,70 @@
+#ifndef COUNTER_GAME_GENERATOR_H
+#define COUNTER_GAME_GENERATOR_H
+
+#include <string>
+#include <vector>
+
+#include "BenchmarkInstance.h"
+
+namespace Syft {
+
+/**
+ * \brief Generates the counter game benchmarks (see the CounterGames folder).
+ *
+ * The agent has to set all bits of an n-bit binary counter, which it can only
+ * increment when the environment issues the request "add". Environment tier
+ * i guarantees that "add" holds in each of the first steps of the trace, and
+ * more determined tiers guarantee it for more steps. All tiers share a core
+ * of \a core steps.
+ *
+ * The benchmark core_c/envs_n shipped for a given mode corresponds to
+ * core = c and tiers = n - c + 1.
+ */
+class CounterGameGenerator {
+ private:
+
+  static std::string next(std::size_t steps, const std::string& formula);
+
+  static std::string add_requests(std::size_t first_step,
+                                  std::size_t last_step);
+
+ public:
+
+  /**
+   * \brief Returns the agent goal for a counter with \a bits bits.
+   */
+  static std::string goal(std::size_t bits);
+
+  /**
+   * \brief Returns the partition for a counter with \a bits bits.
+   *
+   * The only input is "add". The outputs are the bits b_i and carries c_i.
+   */
+  static InputOutputPartition partition(std::size_t bits);
+
+  /**
+   * \brief Returns the environment specification in the format of \a mode.
+   *
+   * \param core Number of steps in which every tier guarantees "add".
+   * \param tiers Number of environment tiers.
+   * \param mode Determines the layout of the returned lines.
+   * \return The lines of the environment file for \a mode.
+   */
+  static std::vector<std::string> environment_specs(std::size_t core,
+                                                    std::size_t tiers,
+                                                    SynthesisMode mode);
+
+  /**
+   * \brief Returns a complete counter game instance.
+   *
+   * The environment moves first, as in the shipped benchmarks.
+   */
+  static BenchmarkInstance instance(std::size_t bits,
+                                    std::size_t core,
+                                    std::size_t tiers,
+                                    SynthesisMode mode);
+};
+
+}
+
+#endif // COUNTER_GAME_GENERATOR_H
@@ -0,0 +1,70 @@
+#ifndef ROBOT_NAVIGATION_GENERATOR_H
+#define ROBOT_NAVIGATION_GENERATOR_H
+
+#include <string>
+#include <vector>
+
+#include "BenchmarkInstance.h"
+
+namespace Syft {
+
+/**
+ * \brief Generates the robot navigation benchmarks (see the RobotNavigation
+ * folder).
+ *
+ * The agent moves a robot along a corridor of rooms 1, ..., n, where door d
+ * connects rooms d and d + 1, and has to reach room n. The environment
+ * controls the doors. Tier j of the environment guarantees that doors 1,
+ * ..., n - j stay open forever, so the first tier keeps every door open.
+ */
+class RobotNavigationGenerator {
+ private:
+
+  static std::string move(std::size_t from, std::size_t to);
+
+  static std::vector<std::string> moves(std::size_t rooms);
+
+  static std::string base_environment(std::size_t rooms);
+
+  static std::string open_doors(std::size_t doors);
+
+ public:
+
+  /**
+   * \brief Returns the agent goal for a corridor of \a rooms rooms.
+   */
+  static std::string goal(std::size_t rooms);
+
+  /**
+   * \brief Returns the partition for a corridor of \a rooms rooms.
+   *
+   * The inputs are the robot position at_i and the door status open_d. The
+   * outputs are the moves move_i_j between adjacent rooms and wait.
+   */
+  static InputOutputPartition partition(std::size_t rooms);
+
+  /**
+   * \brief Returns the environment specification in the format of \a mode.
+   *
+   * \param rooms Number of rooms in the corridor.
+   * \param tiers Number of environment tiers, between 1 and \a rooms.
+   * \param mode Determines the layout of the returned lines.
+   * \return The lines of the environment file for \a mode.
+   */
+  static std::vector<std::string> environment_specs(std::size_t rooms,
+                                                    std::size_t tiers,
+                                                    SynthesisMode mode);
+
+  /**
+   * \brief Returns a complete robot navigation instance.
+   *
+   * The agent moves first, as in the shipped benchmarks.
+   */
+  static BenchmarkInstance instance(std::size_t rooms,
+                                    std::size_t tiers,
+                                    SynthesisMode mode);
+};
+
+}
+
+#endif // ROBOT_NAVIGATION_GENERATOR_H
@@ -0,0 +1,71 @@
+#include "BenchmarkInstance.h"
+
+#include <fstream>
+#include <stdexcept>
+
+namespace Syft {
+
+std::string BenchmarkInstance::partition_string() const {
+  std::string result = ".inputs:";
+  for (const std::string& input : partition.input_variables) {
+    result += " " + input;
+  }
+  result += "\n.outputs:";
+  for (const std::string& output : partition.output_variables) {
+    result += " " + output;
+  }
+  result += "\n";
+  return result;
+}
+
+void BenchmarkInstance::write_to_files(const std::string& directory) const {
+  std::string prefix = directory + "/" + name;
+
+  std::ofstream goal_stream(prefix + ".ltlf");
+  goal_stream << goal << std::endl;
+
+  std::ofstream env_stream(prefix + "_envs.ltlf");
+  for (const std::string& env_spec : environment_specs) {
+    env_stream << env_spec << std::endl;
+  }
+
+  std::ofstream part_stream(prefix + ".part");
+  part_stream << partition_string();
+
+  if (!goal_stream || !env_stream || !part_stream) {
+    throw std::runtime_error("Error: Could not write instance " + name +
+                             " to directory " + directory + ".");
+  }
+}
+
+BenchmarkInstance BenchmarkInstance::read_from_files(
+    const std::string& goal_file,
+    const std::string& env_file,
+    const std::string& partition_file,
+    Player starting_player,
+    SynthesisMode mode) {
+  std::ifstream goal_stream(goal_file);
+  std::ifstream env_stream(env_file);
+
+  if (!goal_stream || !env_stream) {
+    throw std::runtime_error("Error: Could not open " +
+                             (goal_stream ? env_file : goal_file) + ".");
+  }
+
+  BenchmarkInstance instance;
+  instance.name = goal_file + ":" + env_file;
+  std::getline(goal_stream, instance.goal);
+
+  std::string env_spec;
+  while (std::getline(env_stream, env_spec)) {
+    instance.environment_specs.push_back(env_spec);
+  }
+
+  instance.partition = InputOutputPartition::read_from_file(partition_file);
+  instance.starting_player = starting_player;
+  instance.mode = mode;
+
+  return instance;
+}
+
+}
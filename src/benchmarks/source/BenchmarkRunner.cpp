@@ -0,0 +1,431 @@
+#include "BenchmarkRunner.h"
+
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+
+#include <poll.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "CommonCoreChainSynthesizer.h"
+#include "Deadline.h"
+#include "EnvironmentsChainBestEffortSynthesizer.h"
+#include "ExplicitStateDfaMona.h"
+#include "RefiningEnvironmentsChainSynthesizer.h"
+#include "Stopwatch.h"
+#include "SynthesisSession.h"
+#include "VarMgr.h"
+
+namespace Syft {
+
+namespace {
+
+// Grace period given to a worker to report its own timeout before it is killed
+const double kKillGracePeriod = 1.0;
+
+std::string single_line(std::string text) {
+  for (char& c : text) {
+    if (c == '\n' || c == '\t') {
+      c = ' ';
+    }
+  }
+  return text;
+}
+
+// Results travel from the workers as a single tab-separated line
+std::string serialize(const BenchmarkResult& result) {
+  std::ostringstream out;
+  out << result.status << '\t' << result.running_time << '\t';
+  for (std::size_t i = 0; i < result.run_times.size(); ++i) {
+    out << (i > 0 ? "," : "") << result.run_times[i];
+  }
+  out << '\t' << result.realizability << '\t' << result.cudd_memory << '\t'
+      << single_line(result.message) << '\n';
+  return out.str();
+}
+
+void deserialize(const std::string& line, BenchmarkResult& result) {
+  std::istringstream in(line);
+  std::string running_time, run_times, cudd_memory;
+
+  std::getline(in, result.status, '\t');
+  std::getline(in, running_time, '\t');
+  std::getline(in, run_times, '\t');
+  std::getline(in, result.realizability, '\t');
+  std::getline(in, cudd_memory, '\t');
+  std::getline(in, result.message);
+
+  result.running_time = running_time.empty() ? 0.0 : std::stod(running_time);
+  result.cudd_memory = cudd_memory.empty() ? 0.0 : std::stod(cudd_memory);
+
+  std::istringstream times(run_times);
+  std::string time;
+  while (std::getline(times, time, ',')) {
+    result.run_times.push_back(std::stod(time));
+  }
+}
+
+std::string csv_field(const std::string& text) {
+  if (text.find_first_of(",\"\n") == std::string::npos) {
+    return text;
+  }
+
+  std::string result = "\"";
+  for (char c : text) {
+    if (c == '"') {
+      result += '"';
+    }
+    result += c;
+  }
+  return result + "\"";
+}
+
+void report_progress(std::size_t index,
+                     std::size_t count,
+                     const BenchmarkResult& result) {
+  std::cout << "[batch-MtSyft] (" << index + 1 << "/" << count << ") "
+            << result.instance << " [" << to_string(result.mode) << "]: "
+            << result.status << " in " << result.running_time << " s";
+  if (!result.message.empty()) {
+    std::cout << " (" << result.message << ")";
+  }
+  std::cout << std::endl;
+}
+
+}
+
+BenchmarkRunner::BenchmarkRunner(double timeout,
+                                 std::size_t memory_limit,
+                                 std::size_t workers,
+                                 bool quiet)
+    : timeout_(timeout),
+      memory_limit_(memory_limit),
+      workers_(workers),
+      quiet_(quiet) {}
+
+void BenchmarkRunner::set_tier_solving(TierSolving tier_solving) {
+  tier_solving_ = tier_solving;
+}
+
+std::vector<BenchmarkInstance> BenchmarkRunner::read_manifest(
+    const std::string& manifest_file) {
+  std::ifstream in(manifest_file);
+
+  if (!in) {
+    throw std::runtime_error("Error: Could not open manifest " +
+                             manifest_file + ".");
+  }
+
+  std::string directory;
+  std::size_t separator = manifest_file.find_last_of('/');
+  if (separator != std::string::npos) {
+    directory = manifest_file.substr(0, separator + 1);
+  }
+
+  auto resolve = [&directory](const std::string& path) {
+    return (path.empty() || path[0] == '/') ? path : directory + path;
+  };
+
+  std::vector<BenchmarkInstance> instances;
+  std::string line;
+  std::size_t line_number = 0;
+
+  while (std::getline(in, line)) {
+    ++line_number;
+
+    std::istringstream fields(line);
+    std::string goal_file, env_file, partition_file, mode;
+    int starting_flag;
+
+    if (!(fields >> goal_file) || goal_file[0] == '#') {
+      continue;
+    }
+
+    if (!(fields >> env_file >> partition_file >> starting_flag >> mode) ||
+        (starting_flag != 0 && starting_flag != 1)) {
+      throw std::runtime_error("Error: Manifest " + manifest_file +
+                               " is badly formatted at line " +
+                               std::to_string(line_number) + ".");
+    }
+
+    instances.push_back(BenchmarkInstance::read_from_files(
+        resolve(goal_file), resolve(env_file), resolve(partition_file),
+        starting_flag == 1 ? Player::Agent : Player::Environment,
+        synthesis_mode_from_string(mode)));
+  }
+
+  return instances;
+}
+
+BenchmarkResult BenchmarkRunner::run(const BenchmarkInstance& instance) const {
+  BenchmarkResult result;
+  result.instance = instance.name;
+  result.mode = instance.mode;
+
+  // a fresh manager per instance, so instances do not interfere
+  std::shared_ptr<VarMgr> var_mgr = std::make_shared<VarMgr>();
+  std::shared_ptr<CUDD::Cudd> mgr = var_mgr->cudd_mgr();
+
+  if (timeout_ > 0) {
+    var_mgr->set_deadline(std::make_shared<Deadline>(timeout_));
+  }
+  if (memory_limit_ > 0) {
+    mgr->SetMaxMemory(memory_limit_ << 20);
+  }
+
+  if (quiet_) {
+    std::cout.setstate(std::ios::badbit);
+  }
+
+  Stopwatch timer;
+  timer.start();
+
+  try {
+    const std::vector<std::string>& specs = instance.environment_specs;
+    ChainedStrategies strategies;
+
+    if (specs.empty()) {
+      throw std::runtime_error("Error: No environment specification given.");
+    }
+
+    switch (instance.mode) {
+      case SynthesisMode::Chain: {
+        EnvironmentsChainBestEffortSynthesizer synthesizer(
+            var_mgr, instance.goal, specs, instance.partition,
+            instance.starting_player);
+        synthesizer.set_tier_solving(tier_solving_);
+        strategies = synthesizer.run();
+        result.run_times = synthesizer.get_run_times();
+        break;
+      }
+      case SynthesisMode::CommonBase: {
+        CommonCoreChainSynthesizer synthesizer(
+            var_mgr, instance.goal, specs.front(),
+            std::vector<std::string>(specs.begin() + 1, specs.end()),
+            instance.partition, instance.starting_player);
+        synthesizer.set_tier_solving(tier_solving_);
+        strategies = synthesizer.run();
+        result.run_times = synthesizer.get_run_times();
+        break;
+      }
+      case SynthesisMode::Refinements: {
+        RefiningEnvironmentsChainSynthesizer synthesizer(
+            var_mgr, instance.goal,
+            std::vector<std::string>(specs.begin(), specs.end() - 1),
+            specs.back(), instance.partition, instance.starting_player);
+        synthesizer.set_tier_solving(tier_solving_);
+        strategies = synthesizer.run();
+        result.run_times = synthesizer.get_run_times();
+        break;
+      }
+    }
+
+    if (strategies.timed_out) {
+      result.status = "timeout";
+    } else {
+      result.status = "done";
+      result.realizability = realizability_string(strategies);
+    }
+  } catch (const DeadlineExceeded&) {
+    result.status = "timeout";
+  } catch (const std::bad_alloc&) {
+    result.status = "memout";
+  } catch (const std::exception& e) {
+    switch (mgr->ReadErrorCode()) {
+      case CUDD_MEMORY_OUT:
+      case CUDD_MAX_MEM_EXCEEDED:
+        result.status = "memout";
+        break;
+      default:
+        result.status = "error";
+        result.message = e.what();
+    }
+  }
+
+  result.running_time = timer.stop().count() / 1000.0;
+  result.cudd_memory = mgr->ReadMemoryInUse() / 1048576.0;
+
+  // the translation of a single formula into a DFA cannot be interrupted
+  if (result.status == "done" && timeout_ > 0 &&
+      result.running_time > timeout_) {
+    result.status = "timeout";
+  }
+
+  if (quiet_) {
+    std::cout.clear();
+  }
+
+  return result;
+}
+
+std::vector<BenchmarkResult> BenchmarkRunner::run_all(
+    const std::vector<BenchmarkInstance>& instances) const {
+  if (workers_ > 0) {
+    return run_in_workers(instances);
+  }
+
+  std::vector<BenchmarkResult> results;
+  for (std::size_t i = 0; i < instances.size(); ++i) {
+    results.push_back(run(instances[i]));
+    report_progress(i, instances.size(), results.back());
+  }
+
+  return results;
+}
+
+std::vector<BenchmarkResult> BenchmarkRunner::run_in_workers(
+    const std::vector<BenchmarkInstance>& instances) const {
+  struct Worker {
+    pid_t pid;
+    int fd;
+    std::size_t index;
+    std::chrono::steady_clock::time_point start;
+    std::string output;
+    bool killed;
+  };
+
+  std::vector<BenchmarkResult> results(instances.size());
+  std::vector<Worker> active;
+  std::size_t next = 0, finished = 0;
+
+  // pre-translates F(true), which the workers then inherit
+  ExplicitStateDfaMona::dfa_of_non_empty_traces();
+
+  while (next < instances.size() || !active.empty()) {
+    while (active.size() < workers_ && next < instances.size()) {
+      int fds[2];
+      if (pipe(fds) != 0) {
+        throw std::runtime_error("Error: Could not create a pipe for a worker.");
+      }
+
+      // otherwise the buffered output is printed again by the child
+      std::cout.flush();
+
+      pid_t pid = fork();
+      if (pid < 0) {
+        throw std::runtime_error("Error: Could not fork a worker.");
+      }
+
+      if (pid == 0) {
+        close(fds[0]);
+
+        if (memory_limit_ > 0) {
+          rlimit limit;
+          limit.rlim_cur = limit.rlim_max = memory_limit_ << 20;
+          setrlimit(RLIMIT_AS, &limit);
+        }
+
+        std::string line = serialize(run(instances[next]));
+        std::size_t written = 0;
+        while (written < line.size()) {
+          ssize_t n = write(fds[1], line.data() + written,
+                            line.size() - written);
+          if (n < 0 && errno != EINTR) {
+            break;
+          }
+          written += n > 0 ? n : 0;
+        }
+
+        close(fds[1]);
+        std::cout.flush();
+        _exit(0);
+      }
+
+      close(fds[1]);
+      active.push_back({pid, fds[0], next, std::chrono::steady_clock::now(),
+                        "", false});
+      results[next].instance = instances[next].name;
+      results[next].mode = instances[next].mode;
+      ++next;
+    }
+
+    std::vector<pollfd> fds;
+    for (const Worker& worker : active) {
+      fds.push_back({worker.fd, POLLIN, 0});
+    }
+    poll(fds.data(), fds.size(), 100);
+
+    for (std::size_t i = active.size(); i-- > 0;) {
+      Worker& worker = active[i];
+      double elapsed = std::chrono::duration<double>(
+          std::chrono::steady_clock::now() - worker.start).count();
+
+      if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) {
+        char buffer[4096];
+        ssize_t n = read(worker.fd, buffer, sizeof(buffer));
+
+        if (n > 0) {
+          worker.output.append(buffer, n);
+          continue;
+        }
+        if (n < 0 && errno == EINTR) {
+          continue;
+        }
+
+        // the worker closed the pipe, so it is done
+        close(worker.fd);
+        int status;
+        waitpid(worker.pid, &status, 0);
+
+        BenchmarkResult& result = results[worker.index];
+        if (!worker.output.empty()) {
+          deserialize(worker.output, result);
+        } else if (worker.killed) {
+          result.status = "timeout";
+          result.running_time = elapsed;
+        } else {
+          result.status = "error";
+          result.running_time = elapsed;
+          result.message = WIFSIGNALED(status) ?
+              "worker terminated by signal " + std::to_string(WTERMSIG(status)) :
+              "worker exited without a result";
+        }
+
+        report_progress(finished++, instances.size(), result);
+        active.erase(active.begin() + i);
+      } else if (timeout_ > 0 && !worker.killed &&
+                 elapsed > timeout_ + kKillGracePeriod) {
+        kill(worker.pid, SIGKILL);
+        worker.killed = true;
+      }
+    }
+  }
+
+  return results;
+}
+
+void BenchmarkRunner::write_results(const std::vector<BenchmarkResult>& results,
+                                    const std::string& filename) {
+  std::ofstream out(filename);
+
+  out << "instance,mode,status,running_time,ltlf2dfa,dfa2symbolic,adv_games,"
+         "coop_games,realizability,cudd_memory_mb,message" << std::endl;
+
+  for (const BenchmarkResult& result : results) {
+    out << csv_field(result.instance) << "," << to_string(result.mode) << ","
+        << result.status << "," << result.running_time;
+    for (std::size_t i = 0; i < 4; ++i) {
+      out << ",";
+      if (i < result.run_times.size()) {
+        out << result.run_times[i];
+      }
+    }
+    out << "," << result.realizability << "," << result.cudd_memory << ","
+        << csv_field(result.message) << std::endl;
+  }
+
+  if (!out) {
+    throw std::runtime_error("Error: Could not write results to " +
+                             filename + ".");
+  }
+}
+
+}
@@ -0,0 +1,138 @@
+#include "CounterGameGenerator.h"
+
+#include <stdexcept>
+
+namespace Syft {
+
+std::string CounterGameGenerator::next(std::size_t steps,
+                                       const std::string& formula) {
+  std::string result = formula;
+
+  for (std::size_t i = 0; i < steps; ++i) {
+    result = "X(" + result + ")";
+  }
+
+  return result;
+}
+
+std::string CounterGameGenerator::add_requests(std::size_t first_step,
+                                               std::size_t last_step) {
+  std::string result = next(first_step, "add");
+
+  for (std::size_t i = first_step + 1; i <= last_step; ++i) {
+    result += " & " + next(i, "add");
+  }
+
+  return result;
+}
+
+std::string CounterGameGenerator::goal(std::size_t bits) {
+  if (bits < 1) {
+    throw std::runtime_error("Error: A counter needs at least one bit.");
+  }
+
+  // Initially, all bits and carries are off
+  std::string initial = "!c0 & !b0 & !c1";
+  std::string all_bits_set = "b0";
+  for (std::size_t i = 1; i < bits; ++i) {
+    initial += " & !b" + std::to_string(i) + " & !c" + std::to_string(i + 1);
+    all_bits_set += " & b" + std::to_string(i);
+  }
+
+  std::string result = "(" + initial + ") & F(" + all_bits_set + ")";
+
+  // Without a request there is no carry into the least significant bit
+  result += " & G((!add) -> X(!c0))";
+
+  // Bit i and carry i + 1 are the sum of bit i and carry i
+  for (std::size_t i = 0; i < bits; ++i) {
+    std::string c = "c" + std::to_string(i);
+    std::string b = "b" + std::to_string(i);
+    std::string next_c = "c" + std::to_string(i + 1);
+
+    result += " & G(((!" + c + ") & (!" + b + ")) -> X((!" + b + ") & (!" +
+              next_c + ")))";
+    result += " & G(((!" + c + ") & " + b + ") -> X(" + b + " & (!" +
+              next_c + ")))";
+    result += " & G((" + c + " & (!" + b + ")) -> X(" + b + " & (!" +
+              next_c + ")))";
+    result += " & G((" + c + " & " + b + ") -> X((!" + b + ") & " +
+              next_c + "))";
+  }
+
+  return result;
+}
+
+InputOutputPartition CounterGameGenerator::partition(std::size_t bits) {
+  InputOutputPartition partition;
+  partition.input_variables.push_back("add");
+
+  partition.output_variables.push_back("c0");
+  for (std::size_t i = 0; i < bits; ++i) {
+    partition.output_variables.push_back("b" + std::to_string(i));
+    partition.output_variables.push_back("c" + std::to_string(i + 1));
+  }
+
+  return partition;
+}
+
+std::vector<std::string> CounterGameGenerator::environment_specs(
+    std::size_t core,
+    std::size_t tiers,
+    SynthesisMode mode) {
+  if (core < 1 || tiers < 1) {
+    throw std::runtime_error(
+        "Error: Counter games need a non-empty core and at least one tier.");
+  }
+
+  // The most determined tier guarantees a request in steps 0, ..., horizon
+  std::size_t horizon = core + tiers - 2;
+  std::vector<std::string> specs;
+
+  switch (mode) {
+    case SynthesisMode::Chain:
+      // E_i guarantees requests in steps 0, ..., horizon - i + 1
+      for (std::size_t last = horizon + 1; last-- > core - 1;) {
+        specs.push_back("(" + add_requests(0, last) + ")");
+      }
+      break;
+
+    case SynthesisMode::CommonBase:
+      // Base guarantees the core, refinements the remaining steps
+      specs.push_back("(" + add_requests(0, core - 1) + ")");
+      for (std::size_t last = horizon + 1; last-- > core;) {
+        specs.push_back("(" + add_requests(core, last) + ")");
+      }
+      specs.push_back("true");
+      break;
+
+    case SynthesisMode::Refinements:
+      // Each refinement adds the request of a single step to the base
+      for (std::size_t step = horizon + 1; step-- > core;) {
+        specs.push_back(next(step, "add"));
+      }
+      specs.push_back("(" + add_requests(0, core - 1) + ")");
+      break;
+  }
+
+  return specs;
+}
+
+BenchmarkInstance CounterGameGenerator::instance(std::size_t bits,
+                                                 std::size_t core,
+                                                 std::size_t tiers,
+                                                 SynthesisMode mode) {
+  BenchmarkInstance instance;
+  instance.name = "counter_" + std::to_string(bits) + "_core_" +
+                  std::to_string(core) + "_tiers_" + std::to_string(tiers) +
+                  "_" + to_string(mode);
+  instance.goal = goal(bits);
+  instance.environment_specs = environment_specs(core, tiers, mode);
+  instance.partition = partition(bits);
+  instance.starting_player = Player::Environment;
+  instance.mode = mode;
+
+  return instance;
+}
+
+}
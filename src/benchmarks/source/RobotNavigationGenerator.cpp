@@ -0,0 +1,200 @@
+#include "RobotNavigationGenerator.h"
+
+#include <stdexcept>
+
+namespace Syft {
+
+namespace {
+
+std::string join(const std::vector<std::string>& items,
+                 const std::string& separator) {
+  std::string result;
+
+  for (std::size_t i = 0; i < items.size(); ++i) {
+    if (i > 0) {
+      result += separator;
+    }
+    result += items[i];
+  }
+
+  return result;
+}
+
+std::string at(std::size_t room) {
+  return "at_" + std::to_string(room);
+}
+
+std::string open(std::size_t door) {
+  return "open_" + std::to_string(door);
+}
+
+}
+
+std::string RobotNavigationGenerator::move(std::size_t from, std::size_t to) {
+  return "move_" + std::to_string(from) + "_" + std::to_string(to);
+}
+
+std::vector<std::string> RobotNavigationGenerator::moves(std::size_t rooms) {
+  std::vector<std::string> result;
+
+  for (std::size_t door = 1; door < rooms; ++door) {
+    result.push_back(move(door, door + 1));
+    result.push_back(move(door + 1, door));
+  }
+  result.push_back("wait");
+
+  return result;
+}
+
+std::string RobotNavigationGenerator::base_environment(std::size_t rooms) {
+  // Initially, the robot is in room 1 and all doors are open
+  std::vector<std::string> initial = {at(1)};
+  for (std::size_t room = 2; room <= rooms; ++room) {
+    initial.push_back("!" + at(room));
+    initial.push_back(open(room - 1));
+  }
+
+  // The robot is in a room next iff it stays there or it enters it
+  std::vector<std::string> frame;
+  for (std::size_t room = 1; room <= rooms; ++room) {
+    std::vector<std::string> leave;
+    std::vector<std::string> enter;
+
+    if (room > 1) {
+      leave.push_back(move(room, room - 1));
+      enter.push_back(move(room - 1, room));
+    }
+    if (room < rooms) {
+      leave.push_back(move(room, room + 1));
+      enter.push_back(move(room + 1, room));
+    }
+
+    frame.push_back("(X(" + at(room) + ") <-> ((" + at(room) + " && !(" +
+                    join(leave, " || ") + ")) || (" + join(enter, " || ") +
+                    ")))");
+  }
+
+  return "((" + join(initial, " && ") + ") && ((" + join(frame, " && ") +
+         ")U(!X[!](true))))";
+}
+
+std::string RobotNavigationGenerator::open_doors(std::size_t doors) {
+  std::vector<std::string> result;
+
+  for (std::size_t door = 1; door <= doors; ++door) {
+    result.push_back("G(" + open(door) + ")");
+  }
+
+  return join(result, " && ");
+}
+
+std::string RobotNavigationGenerator::goal(std::size_t rooms) {
+  if (rooms < 2) {
+    throw std::runtime_error("Error: A corridor needs at least two rooms.");
+  }
+
+  std::vector<std::string> all_moves = moves(rooms);
+
+  // Exactly one move is performed at each step
+  std::vector<std::string> mutex;
+  for (const std::string& m : all_moves) {
+    std::vector<std::string> others;
+    for (const std::string& other : all_moves) {
+      if (other != m) {
+        others.push_back("!" + other);
+      }
+    }
+    mutex.push_back("(G((" + m + ") -> (" + join(others, " && ") + ")))");
+  }
+
+  // A move requires the robot to be in the room and the door to be open
+  std::vector<std::string> preconditions;
+  for (std::size_t door = 1; door < rooms; ++door) {
+    preconditions.push_back("(G((" + move(door, door + 1) + ") -> ((" +
+                            at(door) + " && " + open(door) + "))))");
+    preconditions.push_back("(G((" + move(door + 1, door) + ") -> ((" +
+                            at(door + 1) + " && " + open(door) + "))))");
+  }
+  preconditions.push_back("(G((wait)-> true))");
+
+  return "((F(" + at(rooms) + ")) && ((G(" + join(all_moves, " || ") +
+         ")) && (" + join(mutex, " && ") + ") && (" +
+         join(preconditions, " && ") + ")))";
+}
+
+InputOutputPartition RobotNavigationGenerator::partition(std::size_t rooms) {
+  InputOutputPartition partition;
+
+  partition.input_variables.push_back(at(1));
+  for (std::size_t room = 2; room <= rooms; ++room) {
+    partition.input_variables.push_back(at(room));
+    partition.input_variables.push_back(open(room - 1));
+  }
+  partition.output_variables = moves(rooms);
+
+  return partition;
+}
+
+std::vector<std::string> RobotNavigationGenerator::environment_specs(
+    std::size_t rooms,
+    std::size_t tiers,
+    SynthesisMode mode) {
+  if (rooms < 2 || tiers < 1 || tiers > rooms) {
+    throw std::runtime_error(
+        "Error: Robot navigation needs at least two rooms and between one "
+        "tier and as many tiers as rooms.");
+  }
+
+  std::size_t doors = rooms - 1;
+  std::string base = base_environment(rooms);
+  std::vector<std::string> specs;
+
+  switch (mode) {
+    case SynthesisMode::Chain:
+      // Tier j keeps doors 1, ..., doors - j open
+      for (std::size_t j = 0; j < tiers; ++j) {
+        std::size_t open_count = doors - j;
+        specs.push_back(open_count == 0 ?
+                        base : base + " && " + open_doors(open_count));
+      }
+      break;
+
+    case SynthesisMode::CommonBase:
+      specs.push_back(base);
+      for (std::size_t j = 0; j < tiers; ++j) {
+        std::size_t open_count = doors - j;
+        specs.push_back(open_count == 0 ? "true" : open_doors(open_count));
+      }
+      break;
+
+    case SynthesisMode::Refinements: {
+      // Refinement j keeps door doors - j open on top of the weakest tier
+      for (std::size_t j = 0; j + 1 < tiers; ++j) {
+        specs.push_back("G(" + open(doors - j) + ")");
+      }
+      std::size_t open_count = rooms - tiers;
+      specs.push_back(open_count == 0 ?
+                      base : base + " && " + open_doors(open_count));
+      break;
+    }
+  }
+
+  return specs;
+}
+
+BenchmarkInstance RobotNavigationGenerator::instance(std::size_t rooms,
+                                                     std::size_t tiers,
+                                                     SynthesisMode mode) {
+  BenchmarkInstance instance;
+  instance.name = "navigation_" + std::to_string(rooms) + "_tiers_" +
+                  std::to_string(tiers) + "_" + to_string(mode);
+  instance.goal = goal(rooms);
+  instance.environment_specs = environment_specs(rooms, tiers, mode);
+  instance.partition = partition(rooms);
+  instance.starting_player = Player::Agent;
+  instance.mode = mode;
+
+  return instance;
+}
+
+}
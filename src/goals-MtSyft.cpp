@@ -0,0 +1,177 @@
+#include <string>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <CLI/CLI.hpp>
+#include "Deadline.h"
+#include "ExplicitStateDfaMona.h"
+#include "HybridArenaBuilder.h"
+#include "Profiler.h"
+#include "ConjunctiveDfa.h"
+#include "IndependentSubgameSynthesizer.h"
+#include "SymbolicStateDfa.h"
+#include "InputOutputPartition.h"
+#include "SynthesisSession.h"
+#include "VarMgr.h"
+using namespace std;
+
+int main(int argc, char **argv)
+{
+
+    CLI::App app {
+        "goals-MtSyft: Solves a list of LTLf goals against the same multi-tier environment, translating the environment only once"
+    };
+
+    std::string goals_file, env_file, part_file, mode = "mtsyft", output_file;
+    int starting_flag;
+
+    app.add_option("-l,--goal-list", goals_file, "File with one LTLf goal per line (empty lines and lines starting with # are ignored)")->
+        required() -> check(CLI::ExistingFile);
+
+    app.add_option("-e,--environment-file", env_file, "File to environment tiers, read according to the mode")->
+        required() -> check(CLI::ExistingFile);
+
+    app.add_option("-p,--partition-file", part_file, "File to partition")->
+        required() -> check(CLI::ExistingFile);
+
+    app.add_option("-s,--starting-player", starting_flag, "Starting player (agent=1, environment=0)")->
+        required();
+
+    app.add_option("-m,--mode", mode, "Synthesis algorithm: mtsyft, cb-mtsyft or conj-mtsyft (default mtsyft)")->
+        check(CLI::IsMember({"mtsyft", "cb-mtsyft", "conj-mtsyft"}));
+
+    app.add_option("-o,--output-file", output_file, "File where a table with the times and realizability of each goal is written (default none)");
+
+    double timeout = 0;
+    app.add_option("-T,--timeout", timeout, "Time limit per goal in seconds (default none)")->
+        check(CLI::NonNegativeNumber);
+
+    std::string backend = "lydia";
+    app.add_option("-b,--backend", backend, "Translation of LTLf formulas into DFAs: lydia (compositional) or mona (first-order encoding, as by ltlf2fol) (default lydia)")->
+        check(CLI::IsMember({"lydia", "mona"}));
+
+    std::string tier_games = "all";
+    app.add_option("-g,--games", tier_games, "Games solved for each tier: all, skip (no restriction and cooperative games for tiers realizable from the initial state) or frontier (also decides the realizability of the other tiers by binary search, assuming the tiers are monotone) (default all)")->
+        check(CLI::IsMember({"all", "skip", "frontier"}));
+
+    bool minimize_arenas = false;
+    app.add_flag("--minimize", minimize_arenas, "Minimizes the game arenas modulo bisimulation before solving the games");
+
+    bool dont_cares = false;
+    app.add_flag("--dont-cares", dont_cares, "Treats the codes of the state variables that encode no state as don't-cares, minimizing the transition and final-state BDDs against the valid codes");
+
+    bool decompose = false;
+    app.add_flag("--decompose", decompose, "Translates the top-level conjuncts of each LTLf formula into separate DFAs (in parallel with the MONA backend) and composes them symbolically");
+
+    bool subgames = false;
+    app.add_flag("--subgames", subgames, "Solves the adversarial games as independent subgames when the goal and environment DFAs read disjoint input and output variables (not with --minimize)");
+
+    std::size_t explicit_budget = 0;
+    app.add_option("--explicit-budget", explicit_budget, "Multiplies the env core and each conjunct (cb-mtsyft mode) explicitly, minimized by MONA, when the product of their state counts is at most this budget (default 0, i.e. never)");
+
+    std::string bdd_backend = "cudd";
+    std::vector<std::string> bdd_backends = {"cudd"}; // only the packages compiled in
+    if (Syft::bdd_backend_available(Syft::BddBackendKind::Sylvan)) bdd_backends.push_back("sylvan");
+    app.add_option("--bdd", bdd_backend, "BDD package that solves the games: cudd or sylvan (multi-core, if built with SYFT_WITH_SYLVAN) (default cudd)")->
+        check(CLI::IsMember(bdd_backends));
+
+    std::string trace_file;
+    app.add_option("--trace", trace_file, "File where a Chrome trace of the translations, symbolizations, products, games and fixpoint iterations is written, to be opened in chrome://tracing or Perfetto (default none)");
+
+    CLI11_PARSE(app, argc, argv);
+
+    if (!trace_file.empty()) Syft::Profiler::enable();
+
+    try {
+        Syft::HybridArenaBuilder::set_state_budget(explicit_budget);
+
+        Syft::SymbolicStateDfa::set_dont_care_encoding(dont_cares);
+
+        Syft::ConjunctiveDfa::set_decomposition(decompose);
+
+        Syft::IndependentSubgameSynthesizer::set_subgame_detection(subgames);
+
+        Syft::ExplicitStateDfaMona::set_translation_backend(
+            Syft::translation_backend_from_string(backend));
+
+        // read LTLf goals
+        std::vector<std::string> goals;
+        std::ifstream goals_stream(goals_file);
+        std::string goal;
+        while (std::getline(goals_stream, goal)) {
+            if (goal.empty() || goal[0] == '#') continue;
+            goals.push_back(goal);
+        }
+
+        // read LTLf env specs
+        std::vector<std::string> env_specs;
+        std::ifstream env_specs_stream(env_file);
+        std::string env_spec;
+        while (std::getline(env_specs_stream, env_spec)) {
+            env_specs.push_back(env_spec);
+        }
+
+        Syft::Player starting_player =
+            starting_flag == 1 ? Syft::Player::Agent : Syft::Player::Environment;
+
+        Syft::InputOutputPartition partition =
+            Syft::InputOutputPartition::read_from_file(part_file);
+
+        std::shared_ptr<Syft::VarMgr> var_mgr = std::make_shared<Syft::VarMgr>();
+        var_mgr->set_bdd_backend(Syft::bdd_backend_from_string(bdd_backend));
+
+        Syft::SynthesisSession session(env_specs, partition, starting_player,
+                                       Syft::synthesis_mode_from_string(mode), var_mgr);
+        session.set_tier_solving(Syft::tier_solving_from_string(tier_games));
+        session.set_arena_minimization(minimize_arenas);
+
+        std::cout << "[goals-MtSyft] environment tiers translated in " << session.setup_time() << " s" << std::endl;
+
+        std::vector<Syft::GoalResult> results;
+        for (const auto& goal : goals) {
+            if (timeout > 0) session.var_mgr()->set_deadline(std::make_shared<Syft::Deadline>(timeout));
+
+            results.push_back(session.synthesize(goal));
+            const Syft::GoalResult& result = results.back();
+
+            std::cout << "[goals-MtSyft] goal " << results.size() << " of " << goals.size() << ": ";
+            if (result.strategies.timed_out) std::cout << "timeout";
+            else std::cout << Syft::realizability_string(result.strategies);
+            std::cout << " (" << result.running_time << " s)" << std::endl;
+        }
+
+        session.var_mgr()->set_deadline(nullptr);
+
+        // the results are already in, so a trace that cannot be written is not fatal
+        if (!trace_file.empty()) {
+            try {
+                Syft::Profiler::write_chrome_trace(trace_file);
+            } catch (const std::exception& e) {
+                cerr << e.what() << endl;
+            }
+        }
+
+        std::cout << "[goals-MtSyft] environment restrictions reused " << session.environment_cache().region_hits() << " times" << std::endl;
+        std::cout << "[goals-MtSyft] DFAs reused: " << Syft::ConjunctiveDfa::memo_hits() << " translations, " << session.environment_cache().dfa_hits() << " symbolizations" << std::endl;
+
+        if (!output_file.empty()) {
+            std::ofstream out_stream(output_file);
+            out_stream << "goal,status,running_time,ltlf2dfa,dfa2symbolic,adv_games,coop_games,realizability" << std::endl;
+            for (const auto& result : results) {
+                out_stream << "\"" << result.goal << "\"," << (result.strategies.timed_out ? "timeout" : "done") << "," << result.running_time;
+                for (std::size_t i = 0; i < 4; ++i) {
+                    out_stream << ",";
+                    if (i < result.run_times.size()) out_stream << result.run_times[i];
+                }
+                out_stream << "," << (result.strategies.timed_out ? "" : Syft::realizability_string(result.strategies)) << std::endl;
+            }
+            std::cout << "[goals-MtSyft] Results written to " << output_file << std::endl;
+        }
+    } catch (const std::exception& e) {
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
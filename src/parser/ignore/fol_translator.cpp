@@ -0,0 +1,56 @@
+#include "fol_translator.h"
+
+#include <stdexcept>
+
+#include "ltlf2fol.h"
+
+namespace Syft {
+
+FolProgram ltlf_to_fol(const std::string& formula) {
+  ltl_formula* root = getAST(formula.c_str());
+
+  if (root == NULL) {
+    throw std::runtime_error("Error: Could not parse the LTLf formula " +
+                             formula + " for MONA.");
+  }
+
+  std::set<std::string> alphabet = get_alphabet(root);
+
+  // Lydia's last and end have no counterpart in ltlf2fol, which would read
+  // them as propositions
+  if (alphabet.count("last") > 0 || alphabet.count("end") > 0) {
+    destroy_formula(root);
+    throw std::runtime_error("Error: The LTLf formula " + formula +
+                             " uses last or end, not supported by MONA's"
+                             " translation.");
+  }
+
+  FolProgram result;
+  std::set<std::string> mona_names;
+
+  for (const std::string& proposition : alphabet) {
+    std::string mona_name = up(proposition);
+
+    if (!mona_names.insert(mona_name).second) {
+      destroy_formula(root);
+      throw std::runtime_error("Error: Propositions of " + formula +
+                               " differ only in case.");
+    }
+
+    result.propositions.push_back(proposition);
+    result.mona_names.push_back(mona_name);
+  }
+
+  ltl_formula* bnf_root = bnf(root);
+  ltl_formula* nnf_root = nnf(bnf_root);
+
+  result.program = ltlf2fol_program(nnf_root);
+
+  destroy_formula(root);
+  destroy_formula(bnf_root);
+  destroy_formula(nnf_root);
+
+  return result;
+}
+
+}
@@ -0,0 +1,34 @@
+#ifndef FOL_TRANSLATOR_H
+#define FOL_TRANSLATOR_H
+
+#include <string>
+#include <vector>
+
+namespace Syft {
+
+/**
+ * \brief An LTLf formula translated into a MONA program.
+ */
+struct FolProgram {
+  std::string program;                    // m2l-str program, as by ltlf2fol
+  std::vector<std::string> propositions;  // as written in the formula
+  std::vector<std::string> mona_names;    // variable of each proposition
+};
+
+/**
+ * \brief Translates an LTLf formula into first-order logic, in process.
+ *
+ * The formula is put in NNF and translated as by "ltlf2fol NNF", so X is the
+ * strong and N (or WX) the weak next. The propositions of the formula become
+ * second-order variables in upper case.
+ *
+ * \param formula An LTLf formula in the syntax of ltlf2fol.
+ * \return The MONA program of \a formula.
+ * \throws std::runtime_error If \a formula cannot be parsed, or uses LTLf
+ *   operators that ltlf2fol does not support.
+ */
+FolProgram ltlf_to_fol(const std::string& formula);
+
+}
+
+#endif // FOL_TRANSLATOR_H
@@ -39,6 +39,22 @@ void ltlf2fol (ltl_formula *root)
 
 }
 
+string ltlf2fol_program (ltl_formula *root)
+{
+  int c = 1;
+  string res = "m2l-str;\n";
+
+  // unlike ltlf2fol, the header is kept for formulas without propositions,
+  // otherwise MONA would read the program in WS1S
+  set<string> P = get_alphabet (root);
+  if(!P.empty()){
+    res += "var2 "+alphabet_no_comma(root)+";\n";
+  }
+
+  res += trans_fol(root, 0, c)+";\n";
+  return res;
+}
+
 void print_alphabet_no_comma (ltl_formula* root){
   set<string> P = get_alphabet (root);
   if(!P.empty()){
@@ -232,6 +248,8 @@ string up(string a){
 
 
 
+#ifndef LTLF2FOL_LIBRARY
+
 char in[MAXN];
 
 int main (int argc, char ** argv)
@@ -281,8 +299,4 @@ int main (int argc, char ** argv)
     //destroy_formula (nnfroot);
 }
 
-
-
-
-
-
+#endif
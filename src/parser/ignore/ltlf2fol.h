@@ -45,6 +45,11 @@ std::string get_var (ltl_formula*);
 
 void ltlf2fol (ltl_formula*);
 
+/*
+ * return the MONA program printed by ltlf2fol, instead of printing it
+*/
+std::string ltlf2fol_program (ltl_formula*);
+
 std::string trans_fol (ltl_formula*, int, int&);
 
 void printvars (ltl_formula*);
@@ -14,7 +14,10 @@ extern "C" {
 
 int yyerror(ltl_formula **formula, yyscan_t scanner, const char *msg) {
 	fprintf (stderr, "\033[31mERROR\033[0m: %s\n", msg);
+#ifndef LTLF2FOL_LIBRARY
+	/* the tools do not check the result of getAST */
 	exit(1);
+#endif
 	return 0;
 }
 
@@ -54,6 +57,7 @@ typedef void* yyscan_t;
 %token TOKEN_FALSE
 %token TOKEN_LPAREN
 %token TOKEN_RPAREN
+%token TOKEN_ERROR
 %token <var_name> TOKEN_VARIABLE
  
 %type <formula> expr
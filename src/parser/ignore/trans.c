@@ -26,6 +26,8 @@ getAST (const char *input)
   if (yyparse (&formula, scanner))
     {
       // error parsing
+      yy_delete_buffer (state, scanner);
+      yylex_destroy (scanner);
       return NULL;
     }
 
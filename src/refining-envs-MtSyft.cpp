@@ -7,6 +7,13 @@
 #include "InputOutputPartition.h"
 #include "EnvironmentsChainBestEffortSynthesizer.h"
 #include "VarMgr.h"
+#include "Deadline.h"
+#include "ExplicitStateDfaMona.h"
+#include "FormulaSimplifier.h"
+#include "Profiler.h"
+#include "ConjunctiveDfa.h"
+#include "IndependentSubgameSynthesizer.h"
+#include "SymbolicStateDfa.h"
 #include "Transducer.h"
 #include "RefiningEnvironmentsChainSynthesizer.h"
 using namespace std;
@@ -40,8 +47,46 @@ int main(int argc, char** argv)
     bool benchmark_testing = false;
     app.add_flag("-t,--store-results", benchmark_testing, "Specifies results should be stored in results.csv");
 
+    double timeout = 0;
+    app.add_option("-T,--timeout", timeout, "Time limit in seconds. When it expires, the run stops and reports the times collected so far (default none)")->
+        check(CLI::NonNegativeNumber);
+
+    std::string backend = "lydia";
+    app.add_option("-b,--backend", backend, "Translation of LTLf formulas into DFAs: lydia (compositional) or mona (first-order encoding, as by ltlf2fol) (default lydia)")->
+        check(CLI::IsMember({"lydia", "mona"}));
+
+    std::string tier_games = "all";
+    app.add_option("-g,--games", tier_games, "Games solved for each tier: all, skip (no restriction and cooperative games for tiers realizable from the initial state) or frontier (also decides the realizability of the other tiers by binary search, assuming the tiers are monotone) (default all)")->
+        check(CLI::IsMember({"all", "skip", "frontier"}));
+
+    bool minimize_arenas = false;
+    app.add_flag("--minimize", minimize_arenas, "Minimizes the game arenas modulo bisimulation before solving the games");
+
+    bool dont_cares = false;
+    app.add_flag("--dont-cares", dont_cares, "Treats the codes of the state variables that encode no state as don't-cares, minimizing the transition and final-state BDDs against the valid codes");
+
+    bool decompose = false;
+    app.add_flag("--decompose", decompose, "Translates the top-level conjuncts of each LTLf formula into separate DFAs (in parallel with the MONA backend) and composes them symbolically");
+
+    bool subgames = false;
+    app.add_flag("--subgames", subgames, "Solves the adversarial games as independent subgames when the goal and environment DFAs read disjoint input and output variables (not with --minimize)");
+
+    bool simplify_formulas = false;
+    app.add_flag("--simplify", simplify_formulas, "Simplifies the LTLf formulas (constant folding, duplicate conjuncts, negation normal form, temporal rewritings) before translating them into DFAs, reporting their sizes before and after");
+
+    std::string bdd_backend = "cudd";
+    std::vector<std::string> bdd_backends = {"cudd"}; // only the packages compiled in
+    if (Syft::bdd_backend_available(Syft::BddBackendKind::Sylvan)) bdd_backends.push_back("sylvan");
+    app.add_option("--bdd", bdd_backend, "BDD package that solves the games: cudd or sylvan (multi-core, if built with SYFT_WITH_SYLVAN) (default cudd)")->
+        check(CLI::IsMember(bdd_backends));
+
+    std::string trace_file;
+    app.add_option("--trace", trace_file, "File where a Chrome trace of the translations, symbolizations, products, games and fixpoint iterations is written, to be opened in chrome://tracing or Perfetto (default none)");
+
     CLI11_PARSE(app, argc, argv);
 
+    if (!trace_file.empty()) Syft::Profiler::enable();
+
     // agent goal
     string ltlf_goal;
     ifstream goal_spec_stream(goal_file);
@@ -79,8 +124,35 @@ int main(int argc, char** argv)
     std::shared_ptr<Syft::VarMgr> v_mgr =
         std::make_shared<Syft::VarMgr>();
 
+    if (timeout > 0) v_mgr->set_deadline(std::make_shared<Syft::Deadline>(timeout));
+
+    v_mgr->set_bdd_backend(Syft::bdd_backend_from_string(bdd_backend));
+
+    Syft::SymbolicStateDfa::set_dont_care_encoding(dont_cares);
+
+    Syft::ConjunctiveDfa::set_decomposition(decompose);
+
+    Syft::IndependentSubgameSynthesizer::set_subgame_detection(subgames);
+
+    Syft::ExplicitStateDfaMona::set_translation_backend(
+        Syft::translation_backend_from_string(backend));
+
     Syft::Stopwatch timer;
     timer.start();
+
+    if (simplify_formulas) {
+        std::cout << "[conj-MtSyft] simplifying formulas..." << std::endl;
+        auto simplify = [](const std::string& name, std::string& formula) {
+            Syft::FormulaSimplification simplification = Syft::FormulaSimplifier::simplify(formula);
+            std::cout << "\t[conj-MtSyft] " << name << ": ";
+            if (simplification.parsed) std::cout << simplification.original_size << " -> " << simplification.simplified_size << " nodes" << std::endl;
+            else std::cout << "left as is (not LTLf)" << std::endl;
+            formula = simplification.formula;
+        };
+        simplify("goal", ltlf_goal);
+        for (std::size_t i = 0; i < env_refinements.size(); ++i) simplify("env refinement " + std::to_string(i + 1), env_refinements[i]);
+        simplify("env base", base);
+    }
     Syft::RefiningEnvironmentsChainSynthesizer chain_best_effort_synthesizer(
         v_mgr,
         ltlf_goal,
@@ -90,8 +162,38 @@ int main(int argc, char** argv)
         starting_player
     );
 
+    chain_best_effort_synthesizer.set_tier_solving(Syft::tier_solving_from_string(tier_games));
+    chain_best_effort_synthesizer.set_arena_minimization(minimize_arenas);
+
     Syft::ChainedStrategies results = chain_best_effort_synthesizer.run();
 
+    // the results are already in, so a trace that cannot be written is not fatal
+    if (!trace_file.empty()) {
+        try {
+            Syft::Profiler::write_chrome_trace(trace_file);
+        } catch (const std::exception& e) {
+            cerr << e.what() << endl;
+        }
+    }
+
+    if (results.timed_out) {
+        double MILLISEC_PER_SEC = 1000.0, running_time = timer.stop().count() / MILLISEC_PER_SEC;
+        auto op_times = chain_best_effort_synthesizer.get_run_times();
+
+        std::cout << "[conj-MtSyft] Timeout after " << running_time << " s. Times of the operations performed (the last one was interrupted):";
+        for (const auto& op_time : op_times) std::cout << " " << op_time;
+        std::cout << std::endl;
+
+        if (benchmark_testing) {
+            std::ofstream out_stream("timeouts_conj_mtsyft.csv", std::ofstream::app);
+            out_stream << goal_file << "," << env_file << "," << running_time;
+            for (const auto& op_time : op_times) out_stream << "," << op_time;
+            out_stream << std::endl;
+        }
+
+        return 0;
+    }
+
     chain_best_effort_synthesizer.realizability(results.adversarial_results, results.cooperative_results);
 
     double MILLISEC_PER_SEC = 1000.0, running_time = timer.stop().count() / MILLISEC_PER_SEC;
@@ -0,0 +1,83 @@
+#include <string>
+#include <iostream>
+#include <csignal>
+#include <CLI/CLI.hpp>
+#include "ConjunctiveDfa.h"
+#include "ExplicitStateDfaMona.h"
+#include "SynthesisServer.h"
+using namespace std;
+
+namespace {
+
+    Syft::SynthesisServer* running_server = nullptr;
+
+    void stop_server(int)
+    {
+        if (running_server) running_server->stop();
+    }
+
+}
+
+int main(int argc, char **argv)
+{
+
+    CLI::App app {
+        "server-MtSyft: Serves LTLf best-effort synthesis requests on a Unix domain socket, keeping the environment tiers translated between requests"
+    };
+
+    std::string socket_path;
+    app.add_option("-S,--socket", socket_path, "Path of the Unix domain socket to listen on")->
+        required();
+
+    std::size_t requests = 1;
+    app.add_option("-j,--requests", requests, "Number of requests solved at once (default 1)")->
+        check(CLI::PositiveNumber);
+
+    std::size_t memory_budget = 0;
+    app.add_option("-M,--memory-budget", memory_budget, "Memory in MB that the cached sessions may use together before the least recently used ones are dropped (default none)");
+
+    double timeout = 0;
+    app.add_option("-T,--timeout", timeout, "Time limit in seconds of requests that do not set one (default none)")->
+        check(CLI::NonNegativeNumber);
+
+    std::string backend = "lydia";
+    app.add_option("-b,--backend", backend, "Translation of LTLf formulas into DFAs: lydia (compositional) or mona (first-order encoding, as by ltlf2fol) (default lydia)")->
+        check(CLI::IsMember({"lydia", "mona"}));
+
+    CLI11_PARSE(app, argc, argv);
+
+    try {
+        Syft::ExplicitStateDfaMona::set_translation_backend(
+            Syft::translation_backend_from_string(backend));
+
+        // the server runs indefinitely, so the DFAs are only kept with the
+        // cached sessions, within their memory budget
+        Syft::ConjunctiveDfa::set_memoization(false);
+
+        Syft::SynthesisServer server(socket_path, requests, memory_budget, timeout);
+
+        // without SA_RESTART, so that the server notices the signal while waiting
+        running_server = &server;
+        struct sigaction action = {};
+        action.sa_handler = stop_server;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGINT, &action, nullptr);
+        sigaction(SIGTERM, &action, nullptr);
+
+        // the synthesizers report their progress on the standard output, which
+        // requests running concurrently would interleave
+        std::cout.setstate(std::ios::badbit);
+
+        cerr << "[server-MtSyft] listening on " << socket_path << endl;
+        server.run();
+        cerr << "[server-MtSyft] stopped with " << server.session_count() << " cached session(s)" << endl;
+
+        running_server = nullptr;
+    } catch (const std::exception& e) {
+        running_server = nullptr;
+        cerr << e.what() << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+#ifndef JSON_H
+#define JSON_H
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Syft {
+
+/**
+ * \brief A JSON value, as exchanged by the synthesis server.
+ *
+ * Only what the server needs is supported: numbers are doubles, and strings
+ * are kept as UTF-8 with escapes resolved (\\u escapes outside ASCII are
+ * encoded back to UTF-8).
+ */
+class JsonValue {
+ public:
+
+  enum class Type {
+    Null,
+    Boolean,
+    Number,
+    String,
+    Array,
+    Object
+  };
+
+ private:
+
+  Type type_ = Type::Null;
+  bool boolean_ = false;
+  double number_ = 0.0;
+  std::string string_;
+  std::vector<JsonValue> array_;
+  std::map<std::string, JsonValue> object_;
+
+ public:
+
+  JsonValue() = default;
+  JsonValue(bool value);
+  JsonValue(double value);
+  JsonValue(const char* value);
+  JsonValue(std::string value);
+  JsonValue(std::vector<JsonValue> value);
+  JsonValue(std::map<std::string, JsonValue> value);
+
+  /**
+   * \brief Parses a JSON document.
+   *
+   * Throws an exception if \a text is not a single well-formed JSON value.
+   */
+  static JsonValue parse(std::string_view text);
+
+  /**
+   * \brief Serializes the value on a single line.
+   */
+  std::string dump() const;
+
+  Type type() const;
+
+  bool is_null() const;
+
+  /**
+   * \brief Accessors, which throw an exception if the value has another type.
+   */
+  bool as_boolean() const;
+  double as_number() const;
+  const std::string& as_string() const;
+  const std::vector<JsonValue>& as_array() const;
+  const std::map<std::string, JsonValue>& as_object() const;
+
+  /**
+   * \brief Returns the array of strings held by the value.
+   */
+  std::vector<std::string> as_string_array() const;
+
+  /**
+   * \brief Returns whether the value is an object with member \a key.
+   */
+  bool contains(const std::string& key) const;
+
+  /**
+   * \brief Returns member \a key of an object, throwing an exception if
+   * missing.
+   */
+  const JsonValue& at(const std::string& key) const;
+};
+
+}
+
+#endif // JSON_H
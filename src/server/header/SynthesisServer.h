@@ -0,0 +1,136 @@
+#ifndef SYNTHESIS_SERVER_H
+#define SYNTHESIS_SERVER_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "Json.h"
+#include "Player.h"
+#include "SynthesisMode.h"
+#include "SynthesisSession.h"
+
+namespace Syft {
+
+/**
+ * \brief A long-running process that solves synthesis requests received on a
+ * Unix domain socket.
+ *
+ * Every line received on a connection is a JSON request, e.g.,
+ *
+ *   {"goal": "F(a)", "tiers": ["G(b)", "true"],
+ *    "partition": {"inputs": ["b"], "outputs": ["a"]},
+ *    "starting_player": "agent", "mode": "mtsyft",
+ *    "games": "all", "timeout": 60}
+ *
+ * where "tiers" are the lines of the environment file as read by \a mode, and
+ * "games" and "timeout" are optional. Each request gets a JSON line back with
+ * its "status" (done, timeout, memout or error), "realizability" (one of A, C,
+ * U per tier, separated by ';'), "running_time", "run_times", "warm" (whether
+ * the request found its session already built) and, for errors, "message".
+ *
+ * Requests with the same tiers, partition, starting player and mode share a
+ * SynthesisSession, so the DFAs of the tiers, the variables and the
+ * environment restrictions are kept warm between requests. Requests on the
+ * same session are solved one at a time, requests on different sessions
+ * concurrently, up to the given number of requests at once. When the CUDD
+ * managers of the sessions use more than the memory budget in total, the least
+ * recently used idle sessions are dropped.
+ */
+class SynthesisServer {
+ private:
+
+  using SessionKey = std::tuple<SynthesisMode, Player, std::vector<std::string>,
+                                std::vector<std::string>,
+                                std::vector<std::string>>;
+
+  struct SessionEntry {
+    std::mutex mutex;                      // serializes the requests on the session
+    std::unique_ptr<SynthesisSession> session;
+    // guarded by the server's mutex
+    std::size_t memory_in_use = 0;         // bytes, as of the last request
+    std::size_t users = 0;
+    std::chrono::steady_clock::time_point last_used;
+  };
+
+  std::string socket_path_;
+  std::size_t max_requests_;
+  std::size_t memory_budget_;              // bytes, 0 for none
+  double default_timeout_;
+
+  int listen_fd_ = -1;
+  std::atomic<bool> stop_requested_;
+
+  std::mutex mutex_;
+  std::condition_variable slots_;
+  std::condition_variable connections_done_;
+  std::map<SessionKey, std::shared_ptr<SessionEntry>> sessions_;
+  std::set<int> connections_;
+  std::size_t running_requests_ = 0;
+
+  void serve_connection(int fd);
+
+  JsonValue handle_request(const std::string& line);
+
+  JsonValue solve(const SessionKey& key, const std::string& goal,
+                  TierSolving tier_solving, double timeout);
+
+  std::shared_ptr<SessionEntry> acquire_session(const SessionKey& key);
+
+  /**
+   * \brief Records the memory used by the session of \a entry and drops idle
+   * sessions if the memory budget is exceeded.
+   */
+  void release_session(const std::shared_ptr<SessionEntry>& entry,
+                       std::size_t memory_in_use);
+
+ public:
+
+  /**
+   * \brief Creates a server, which listens once \a run is called.
+   *
+   * \param socket_path The path of the Unix domain socket, which is replaced
+   *   if it exists.
+   * \param max_requests The number of requests solved at once.
+   * \param memory_budget_mb The memory in MB that the CUDD managers of all
+   *   sessions may use together, or 0 for no budget.
+   * \param default_timeout The time limit in seconds of requests that do not
+   *   give one, or 0 for none.
+   */
+  SynthesisServer(std::string socket_path, std::size_t max_requests,
+                  std::size_t memory_budget_mb, double default_timeout);
+
+  SynthesisServer(const SynthesisServer&) = delete;
+  SynthesisServer& operator=(const SynthesisServer&) = delete;
+
+  ~SynthesisServer();
+
+  /**
+   * \brief Accepts connections until \a stop is called.
+   *
+   * Returns once the connections open at that time have been closed; their
+   * requests in progress are completed first.
+   */
+  void run();
+
+  /**
+   * \brief Makes \a run return. Safe to call from a signal handler.
+   */
+  void stop();
+
+  /**
+   * \brief Returns the number of sessions currently cached.
+   */
+  std::size_t session_count();
+};
+
+}
+
+#endif // SYNTHESIS_SERVER_H
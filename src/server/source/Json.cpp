@@ -0,0 +1,464 @@
+#include "Json.h"
+
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+namespace Syft {
+
+namespace {
+
+class JsonParser {
+ private:
+
+  // arrays and objects are parsed recursively, so their nesting is bounded to
+  // bound the stack
+  static constexpr std::size_t max_depth = 256;
+
+  std::string_view text_;
+  std::size_t position_ = 0;
+  std::size_t depth_ = 0;
+
+  [[noreturn]] void fail(const std::string& message) const {
+    throw std::runtime_error("Error: Malformed JSON at offset " +
+                             std::to_string(position_) + ": " + message + ".");
+  }
+
+  void skip_whitespace() {
+    while (position_ < text_.size() &&
+           (text_[position_] == ' ' || text_[position_] == '\t' ||
+            text_[position_] == '\n' || text_[position_] == '\r')) {
+      ++position_;
+    }
+  }
+
+  char peek() const {
+    return position_ < text_.size() ? text_[position_] : '\0';
+  }
+
+  void expect(char c) {
+    if (peek() != c) {
+      fail(std::string("expected '") + c + "'");
+    }
+    ++position_;
+  }
+
+  void expect_literal(std::string_view literal) {
+    if (text_.substr(position_, literal.size()) != literal) {
+      fail("unknown literal");
+    }
+    position_ += literal.size();
+  }
+
+  static void append_utf8(std::string& out, unsigned code_point) {
+    if (code_point < 0x80) {
+      out += static_cast<char>(code_point);
+    } else if (code_point < 0x800) {
+      out += static_cast<char>(0xC0 | (code_point >> 6));
+      out += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else if (code_point < 0x10000) {
+      out += static_cast<char>(0xE0 | (code_point >> 12));
+      out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+      out += static_cast<char>(0x80 | (code_point & 0x3F));
+    } else {
+      out += static_cast<char>(0xF0 | (code_point >> 18));
+      out += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+      out += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+      out += static_cast<char>(0x80 | (code_point & 0x3F));
+    }
+  }
+
+  unsigned parse_hex4() {
+    if (position_ + 4 > text_.size()) {
+      fail("truncated \\u escape");
+    }
+
+    unsigned value = 0;
+    for (int i = 0; i < 4; ++i) {
+      char c = text_[position_++];
+      value <<= 4;
+      if (c >= '0' && c <= '9') {
+        value |= c - '0';
+      } else if (c >= 'a' && c <= 'f') {
+        value |= c - 'a' + 10;
+      } else if (c >= 'A' && c <= 'F') {
+        value |= c - 'A' + 10;
+      } else {
+        fail("invalid \\u escape");
+      }
+    }
+
+    return value;
+  }
+
+  std::string parse_string() {
+    expect('"');
+    std::string result;
+
+    while (true) {
+      if (position_ >= text_.size()) {
+        fail("unterminated string");
+      }
+
+      char c = text_[position_++];
+
+      if (c == '"') {
+        return result;
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        fail("control character in string");
+      } else if (c != '\\') {
+        result += c;
+        continue;
+      }
+
+      if (position_ >= text_.size()) {
+        fail("unterminated escape");
+      }
+
+      switch (text_[position_++]) {
+        case '"': result += '"'; break;
+        case '\\': result += '\\'; break;
+        case '/': result += '/'; break;
+        case 'b': result += '\b'; break;
+        case 'f': result += '\f'; break;
+        case 'n': result += '\n'; break;
+        case 'r': result += '\r'; break;
+        case 't': result += '\t'; break;
+        case 'u': {
+          unsigned code_point = parse_hex4();
+          // surrogate pair
+          if (code_point >= 0xD800 && code_point < 0xDC00) {
+            if (text_.substr(position_, 2) != "\\u") {
+              fail("unpaired surrogate");
+            }
+            position_ += 2;
+            unsigned low = parse_hex4();
+            if (low < 0xDC00 || low >= 0xE000) {
+              fail("unpaired surrogate");
+            }
+            code_point = 0x10000 + ((code_point - 0xD800) << 10) +
+                         (low - 0xDC00);
+          } else if (code_point >= 0xDC00 && code_point < 0xE000) {
+            fail("unpaired surrogate");
+          }
+          append_utf8(result, code_point);
+          break;
+        }
+        default:
+          fail("invalid escape");
+      }
+    }
+  }
+
+  double parse_number() {
+    std::size_t start = position_;
+
+    if (peek() == '-') {
+      ++position_;
+    }
+    while (position_ < text_.size() &&
+           (std::isdigit(static_cast<unsigned char>(text_[position_])) ||
+            text_[position_] == '.' || text_[position_] == 'e' ||
+            text_[position_] == 'E' || text_[position_] == '+' ||
+            text_[position_] == '-')) {
+      ++position_;
+    }
+
+    std::string number(text_.substr(start, position_ - start));
+    std::size_t parsed = 0;
+    double value = 0.0;
+
+    try {
+      value = std::stod(number, &parsed);
+    } catch (const std::exception&) {
+      parsed = 0;
+    }
+
+    if (parsed == 0 || parsed != number.size()) {
+      position_ = start;
+      fail("invalid number");
+    }
+
+    return value;
+  }
+
+  JsonValue parse_object() {
+    expect('{');
+    std::map<std::string, JsonValue> object;
+    skip_whitespace();
+
+    if (peek() == '}') {
+      ++position_;
+      return JsonValue(std::move(object));
+    }
+
+    while (true) {
+      skip_whitespace();
+      std::string key = parse_string();
+      skip_whitespace();
+      expect(':');
+      object[key] = parse_value();
+      skip_whitespace();
+
+      if (peek() == ',') {
+        ++position_;
+      } else {
+        expect('}');
+        return JsonValue(std::move(object));
+      }
+    }
+  }
+
+  JsonValue parse_array() {
+    expect('[');
+    std::vector<JsonValue> array;
+    skip_whitespace();
+
+    if (peek() == ']') {
+      ++position_;
+      return JsonValue(std::move(array));
+    }
+
+    while (true) {
+      array.push_back(parse_value());
+      skip_whitespace();
+
+      if (peek() == ',') {
+        ++position_;
+      } else {
+        expect(']');
+        return JsonValue(std::move(array));
+      }
+    }
+  }
+
+ public:
+
+  explicit JsonParser(std::string_view text) : text_(text) {}
+
+  JsonValue parse_value() {
+    skip_whitespace();
+
+    switch (peek()) {
+      case '{':
+      case '[': {
+        if (depth_ == max_depth) {
+          fail("nesting deeper than " + std::to_string(max_depth));
+        }
+
+        ++depth_;
+        JsonValue value = peek() == '{' ? parse_object() : parse_array();
+        --depth_;
+        return value;
+      }
+      case '"':
+        return JsonValue(parse_string());
+      case 't':
+        expect_literal("true");
+        return JsonValue(true);
+      case 'f':
+        expect_literal("false");
+        return JsonValue(false);
+      case 'n':
+        expect_literal("null");
+        return JsonValue();
+      default:
+        return JsonValue(parse_number());
+    }
+  }
+
+  void finish() {
+    skip_whitespace();
+    if (position_ != text_.size()) {
+      fail("trailing characters");
+    }
+  }
+};
+
+void dump_string(const std::string& text, std::string& out) {
+  out += '"';
+
+  for (char c : text) {
+    switch (c) {
+      case '"': out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\b': out += "\\b"; break;
+      case '\f': out += "\\f"; break;
+      case '\n': out += "\\n"; break;
+      case '\r': out += "\\r"; break;
+      case '\t': out += "\\t"; break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char escape[7];
+          std::snprintf(escape, sizeof(escape), "\\u%04x", c);
+          out += escape;
+        } else {
+          out += c;
+        }
+    }
+  }
+
+  out += '"';
+}
+
+void dump_value(const JsonValue& value, std::string& out) {
+  switch (value.type()) {
+    case JsonValue::Type::Null:
+      out += "null";
+      break;
+    case JsonValue::Type::Boolean:
+      out += value.as_boolean() ? "true" : "false";
+      break;
+    case JsonValue::Type::Number: {
+      double number = value.as_number();
+      if (!std::isfinite(number)) {
+        out += "null";
+      } else {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.17g", number);
+        out += buffer;
+      }
+      break;
+    }
+    case JsonValue::Type::String:
+      dump_string(value.as_string(), out);
+      break;
+    case JsonValue::Type::Array: {
+      out += '[';
+      bool first = true;
+      for (const JsonValue& element : value.as_array()) {
+        if (!first) {
+          out += ',';
+        }
+        first = false;
+        dump_value(element, out);
+      }
+      out += ']';
+      break;
+    }
+    case JsonValue::Type::Object: {
+      out += '{';
+      bool first = true;
+      for (const auto& [key, member] : value.as_object()) {
+        if (!first) {
+          out += ',';
+        }
+        first = false;
+        dump_string(key, out);
+        out += ':';
+        dump_value(member, out);
+      }
+      out += '}';
+      break;
+    }
+  }
+}
+
+}
+
+JsonValue::JsonValue(bool value) : type_(Type::Boolean), boolean_(value) {}
+
+JsonValue::JsonValue(double value) : type_(Type::Number), number_(value) {}
+
+JsonValue::JsonValue(const char* value)
+  : type_(Type::String), string_(value) {}
+
+JsonValue::JsonValue(std::string value)
+  : type_(Type::String), string_(std::move(value)) {}
+
+JsonValue::JsonValue(std::vector<JsonValue> value)
+  : type_(Type::Array), array_(std::move(value)) {}
+
+JsonValue::JsonValue(std::map<std::string, JsonValue> value)
+  : type_(Type::Object), object_(std::move(value)) {}
+
+JsonValue JsonValue::parse(std::string_view text) {
+  JsonParser parser(text);
+  JsonValue value = parser.parse_value();
+  parser.finish();
+
+  return value;
+}
+
+std::string JsonValue::dump() const {
+  std::string out;
+  dump_value(*this, out);
+
+  return out;
+}
+
+JsonValue::Type JsonValue::type() const {
+  return type_;
+}
+
+bool JsonValue::is_null() const {
+  return type_ == Type::Null;
+}
+
+bool JsonValue::as_boolean() const {
+  if (type_ != Type::Boolean) {
+    throw std::runtime_error("Error: JSON value is not a boolean.");
+  }
+
+  return boolean_;
+}
+
+double JsonValue::as_number() const {
+  if (type_ != Type::Number) {
+    throw std::runtime_error("Error: JSON value is not a number.");
+  }
+
+  return number_;
+}
+
+const std::string& JsonValue::as_string() const {
+  if (type_ != Type::String) {
+    throw std::runtime_error("Error: JSON value is not a string.");
+  }
+
+  return string_;
+}
+
+const std::vector<JsonValue>& JsonValue::as_array() const {
+  if (type_ != Type::Array) {
+    throw std::runtime_error("Error: JSON value is not an array.");
+  }
+
+  return array_;
+}
+
+const std::map<std::string, JsonValue>& JsonValue::as_object() const {
+  if (type_ != Type::Object) {
+    throw std::runtime_error("Error: JSON value is not an object.");
+  }
+
+  return object_;
+}
+
+std::vector<std::string> JsonValue::as_string_array() const {
+  std::vector<std::string> strings;
+
+  for (const JsonValue& element : as_array()) {
+    strings.push_back(element.as_string());
+  }
+
+  return strings;
+}
+
+bool JsonValue::contains(const std::string& key) const {
+  return type_ == Type::Object && object_.find(key) != object_.end();
+}
+
+const JsonValue& JsonValue::at(const std::string& key) const {
+  const std::map<std::string, JsonValue>& object = as_object();
+  auto it = object.find(key);
+
+  if (it == object.end()) {
+    throw std::runtime_error("Error: Missing JSON member " + key + ".");
+  }
+
+  return it->second;
+}
+
+}
@@ -0,0 +1,423 @@
+#include "SynthesisServer.h"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Deadline.h"
+#include "Stopwatch.h"
+#include "VarMgr.h"
+
+namespace Syft {
+
+namespace {
+
+// longest request line accepted on a connection
+constexpr std::size_t kMaxRequestSize = 16 << 20;
+
+std::runtime_error socket_error(const std::string& what) {
+  return std::runtime_error("Error: " + what + ": " + std::strerror(errno) +
+                            ".");
+}
+
+bool send_all(int fd, const std::string& data) {
+  std::size_t sent = 0;
+
+  while (sent < data.size()) {
+    ssize_t n = send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+    if (n < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    sent += n;
+  }
+
+  return true;
+}
+
+JsonValue error_reply(const std::string& message) {
+  return JsonValue(std::map<std::string, JsonValue>{
+      {"status", JsonValue("error")}, {"message", JsonValue(message)}});
+}
+
+Player player_from_json(const JsonValue& value) {
+  if (value.type() == JsonValue::Type::Number) {
+    if (value.as_number() == 1) {
+      return Player::Agent;
+    } else if (value.as_number() == 0) {
+      return Player::Environment;
+    }
+
+    throw std::runtime_error("Error: Unknown starting player " +
+                             value.dump() + ", expected 0 or 1.");
+  }
+
+  const std::string& player = value.as_string();
+  if (player == "agent") {
+    return Player::Agent;
+  } else if (player == "environment") {
+    return Player::Environment;
+  }
+
+  throw std::runtime_error("Error: Unknown starting player " + player +
+                           ", expected agent or environment.");
+}
+
+}
+
+SynthesisServer::SynthesisServer(std::string socket_path,
+                                 std::size_t max_requests,
+                                 std::size_t memory_budget_mb,
+                                 double default_timeout)
+  : socket_path_(std::move(socket_path)),
+    max_requests_(max_requests > 0 ? max_requests : 1),
+    memory_budget_(memory_budget_mb << 20),
+    default_timeout_(default_timeout),
+    stop_requested_(false) {}
+
+SynthesisServer::~SynthesisServer() {
+  if (listen_fd_ >= 0) {
+    close(listen_fd_);
+    unlink(socket_path_.c_str());
+  }
+}
+
+void SynthesisServer::run() {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+
+  if (socket_path_.size() >= sizeof(address.sun_path)) {
+    throw std::runtime_error("Error: Socket path " + socket_path_ +
+                             " is too long.");
+  }
+  std::strcpy(address.sun_path, socket_path_.c_str());
+
+  // close-on-exec, like the connections, so that the MONA processes started
+  // by the games do not keep them open
+  listen_fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (listen_fd_ < 0) {
+    throw socket_error("Cannot create socket");
+  }
+
+  unlink(socket_path_.c_str());
+  if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&address),
+           sizeof(address)) < 0) {
+    throw socket_error("Cannot bind socket " + socket_path_);
+  }
+  if (listen(listen_fd_, SOMAXCONN) < 0) {
+    throw socket_error("Cannot listen on socket " + socket_path_);
+  }
+
+  // accept is polled, so that a stop request is noticed even if no client
+  // connects
+  while (!stop_requested_) {
+    pollfd listen_poll{listen_fd_, POLLIN, 0};
+    int ready = poll(&listen_poll, 1, 200);
+    if (ready <= 0) {
+      if (ready < 0 && errno != EINTR) {
+        throw socket_error("Cannot poll socket " + socket_path_);
+      }
+      continue;
+    }
+
+    int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+    if (fd < 0) {
+      continue;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      connections_.insert(fd);
+    }
+    std::thread(&SynthesisServer::serve_connection, this, fd).detach();
+  }
+
+  close(listen_fd_);
+  listen_fd_ = -1;
+  unlink(socket_path_.c_str());
+
+  // let the connections finish the requests they are solving, and refuse
+  // further ones
+  std::unique_lock<std::mutex> lock(mutex_);
+  for (int fd : connections_) {
+    shutdown(fd, SHUT_RD);
+  }
+  connections_done_.wait(lock, [this] { return connections_.empty(); });
+}
+
+void SynthesisServer::stop() {
+  stop_requested_ = true;
+}
+
+std::size_t SynthesisServer::session_count() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return sessions_.size();
+}
+
+void SynthesisServer::serve_connection(int fd) {
+  std::string buffer;
+  char chunk[4096];
+  bool open = true;
+
+  while (open) {
+    ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      break;
+    }
+    buffer.append(chunk, n);
+
+    std::size_t newline;
+    while (open && (newline = buffer.find('\n')) != std::string::npos) {
+      std::string line = buffer.substr(0, newline);
+      buffer.erase(0, newline + 1);
+
+      if (!line.empty() && line.back() == '\r') {
+        line.pop_back();
+      }
+      if (line.empty()) {
+        continue;
+      }
+
+      open = send_all(fd, handle_request(line).dump() + "\n");
+    }
+
+    if (open && buffer.size() > kMaxRequestSize) {
+      send_all(fd, error_reply("Error: Request too long.").dump() + "\n");
+      open = false;
+    }
+  }
+
+  close(fd);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  connections_.erase(fd);
+  connections_done_.notify_all();
+}
+
+JsonValue SynthesisServer::handle_request(const std::string& line) {
+  SessionKey key;
+  std::string goal;
+  TierSolving tier_solving = TierSolving::All;
+  double timeout = default_timeout_;
+
+  try {
+    JsonValue request = JsonValue::parse(line);
+    const JsonValue& partition = request.at("partition");
+
+    std::string mode = request.contains("mode") ?
+                       request.at("mode").as_string() : "mtsyft";
+    key = SessionKey(synthesis_mode_from_string(mode),
+                     player_from_json(request.at("starting_player")),
+                     request.at("tiers").as_string_array(),
+                     partition.at("inputs").as_string_array(),
+                     partition.at("outputs").as_string_array());
+
+    goal = request.at("goal").as_string();
+
+    if (request.contains("games")) {
+      tier_solving = tier_solving_from_string(request.at("games").as_string());
+    }
+    if (request.contains("timeout")) {
+      timeout = request.at("timeout").as_number();
+    }
+  } catch (const std::exception& e) {
+    return error_reply(e.what());
+  }
+
+  if (std::get<2>(key).empty()) {
+    return error_reply("Error: No environment specification given.");
+  }
+
+  return solve(key, goal, tier_solving, timeout);
+}
+
+JsonValue SynthesisServer::solve(const SessionKey& key, const std::string& goal,
+                                 TierSolving tier_solving, double timeout) {
+  std::map<std::string, JsonValue> reply;
+  std::shared_ptr<SessionEntry> entry = acquire_session(key);
+  std::size_t memory_in_use = 0;
+
+  {
+    std::lock_guard<std::mutex> session_lock(entry->mutex);
+
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      slots_.wait(lock, [this] { return running_requests_ < max_requests_; });
+      ++running_requests_;
+    }
+
+    std::shared_ptr<Deadline> deadline =
+      timeout > 0 ? std::make_shared<Deadline>(timeout) : nullptr;
+    std::shared_ptr<VarMgr> var_mgr = entry->session ?
+                                      entry->session->var_mgr() :
+                                      std::make_shared<VarMgr>();
+    std::shared_ptr<CUDD::Cudd> mgr = var_mgr->cudd_mgr();
+
+    reply["warm"] = JsonValue(entry->session != nullptr);
+
+    Stopwatch timer;
+    timer.start();
+
+    std::string status;
+    try {
+      var_mgr->set_deadline(deadline);
+
+      if (!entry->session) {
+        if (memory_budget_ > 0) {
+          mgr->SetMaxMemory(memory_budget_);
+        }
+
+        const auto& [mode, starting_player, tiers, inputs, outputs] = key;
+        InputOutputPartition partition;
+        partition.input_variables = inputs;
+        partition.output_variables = outputs;
+
+        entry->session = std::make_unique<SynthesisSession>(
+            tiers, partition, starting_player, mode, var_mgr);
+      }
+
+      entry->session->set_tier_solving(tier_solving);
+      GoalResult result = entry->session->synthesize(goal);
+
+      std::vector<JsonValue> run_times;
+      for (double run_time : result.run_times) {
+        run_times.emplace_back(run_time);
+      }
+      reply["run_times"] = JsonValue(std::move(run_times));
+
+      if (result.strategies.timed_out) {
+        status = "timeout";
+      } else {
+        status = "done";
+        reply["realizability"] =
+          JsonValue(realizability_string(result.strategies));
+      }
+    } catch (const DeadlineExceeded&) {
+      status = "timeout";
+    } catch (const std::bad_alloc&) {
+      status = "memout";
+    } catch (const std::exception& e) {
+      switch (mgr->ReadErrorCode()) {
+        case CUDD_MEMORY_OUT:
+        case CUDD_MAX_MEM_EXCEEDED:
+          status = "memout";
+          break;
+        default:
+          status = "error";
+          reply["message"] = JsonValue(e.what());
+      }
+    }
+
+    double running_time = timer.stop().count() / 1000.0;
+
+    // the translation of a single formula into a DFA cannot be interrupted
+    if (status == "done" && timeout > 0 && running_time > timeout) {
+      status = "timeout";
+    }
+
+    reply["status"] = JsonValue(status);
+    reply["running_time"] = JsonValue(running_time);
+
+    var_mgr->set_deadline(nullptr);
+    mgr->ClearErrorCode();
+
+    // a session that ran out of memory may hold half-built caches
+    if (status == "memout") {
+      entry->session.reset();
+    }
+    if (entry->session) {
+      memory_in_use = mgr->ReadMemoryInUse();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --running_requests_;
+    }
+    slots_.notify_one();
+  }
+
+  release_session(entry, memory_in_use);
+
+  return JsonValue(std::move(reply));
+}
+
+std::shared_ptr<SynthesisServer::SessionEntry> SynthesisServer::acquire_session(
+    const SessionKey& key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  std::shared_ptr<SessionEntry>& entry = sessions_[key];
+  if (!entry) {
+    entry = std::make_shared<SessionEntry>();
+  }
+  ++entry->users;
+
+  return entry;
+}
+
+void SynthesisServer::release_session(
+    const std::shared_ptr<SessionEntry>& entry, std::size_t memory_in_use) {
+  std::vector<std::shared_ptr<SessionEntry>> evicted;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    --entry->users;
+    entry->memory_in_use = memory_in_use;
+    entry->last_used = std::chrono::steady_clock::now();
+
+    std::size_t total_memory = 0;
+    for (const auto& [key, cached] : sessions_) {
+      total_memory += cached->memory_in_use;
+    }
+
+    // drop idle sessions, least recently used first, until within budget
+    while (memory_budget_ > 0 && total_memory > memory_budget_) {
+      auto victim = sessions_.end();
+      for (auto it = sessions_.begin(); it != sessions_.end(); ++it) {
+        if (it->second->users == 0 &&
+            (victim == sessions_.end() ||
+             it->second->last_used < victim->second->last_used)) {
+          victim = it;
+        }
+      }
+
+      if (victim == sessions_.end()) {
+        break;
+      }
+
+      total_memory -= victim->second->memory_in_use;
+      evicted.push_back(victim->second);
+      sessions_.erase(victim);
+    }
+
+    // sessions whose creation failed are not kept
+    if (entry->users == 0 && !entry->session) {
+      for (auto it = sessions_.begin(); it != sessions_.end(); ++it) {
+        if (it->second == entry) {
+          sessions_.erase(it);
+          break;
+        }
+      }
+    }
+  }
+
+  if (!evicted.empty()) {
+    std::cerr << "[server-MtSyft] evicted " << evicted.size()
+              << " session(s) to stay within the memory budget" << std::endl;
+  }
+  // the CUDD managers of the evicted sessions are released here, outside the
+  // lock
+}
+
+}
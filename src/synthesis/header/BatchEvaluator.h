@@ -0,0 +1,79 @@
+#ifndef BATCH_EVALUATOR_H
+#define BATCH_EVALUATOR_H
+
+#include <cstdint>
+#include <vector>
+
+#include <cuddObj.hh>
+
+namespace Syft {
+
+/**
+ * \brief Evaluates BDDs on many assignments at once.
+ *
+ * The assignments are bit-sliced: for each variable, a word holds its value
+ * in 64 assignments, one per bit, and \a words consecutive words hold its
+ * value in 64 * \a words assignments. Each node of the BDDs is then evaluated
+ * once for all the assignments with a few word operations, instead of once
+ * per assignment as by CUDD::BDD::Eval. The loop over the words of a node is
+ * vectorized by the compiler, e.g., with \a words = 4 and AVX2 one node is
+ * evaluated on 256 assignments by a single instruction of each kind.
+ *
+ * The BDDs are copied into a flat array when the evaluator is created, so it
+ * does not keep them alive and may outlive them.
+ */
+class BatchEvaluator {
+ private:
+
+  // A reference to a node is its position in nodes_ times 2, plus 1 if the
+  // reference is complemented
+  struct Node {
+    unsigned int variable;
+    std::uint32_t then_child;
+    std::uint32_t else_child;
+  };
+
+  std::vector<Node> nodes_;           // children before parents, constant one
+                                      // first
+  std::vector<std::uint32_t> roots_;
+  std::size_t variable_count_ = 0;
+  mutable std::vector<std::uint64_t> values_;
+
+ public:
+
+  /**
+   * \brief Prepares the evaluation of \a functions.
+   */
+  explicit BatchEvaluator(const std::vector<CUDD::BDD>& functions);
+
+  /**
+   * \brief Returns the number of functions evaluated.
+   */
+  std::size_t function_count() const;
+
+  /**
+   * \brief Returns one plus the largest index of a variable the functions
+   * depend on, i.e., the least number of variables an assignment must have.
+   */
+  std::size_t variable_count() const;
+
+  /**
+   * \brief Evaluates the functions on 64 * \a words assignments.
+   *
+   * Not thread-safe, since the evaluator reuses its buffer of node values.
+   *
+   * \param assignments The bit-sliced assignments, where
+   *   assignments[i * words + w] holds the value of the variable with index i
+   *   in assignments 64 * w to 64 * w + 63, for each i < variable_count().
+   * \param words The number of words per variable.
+   * \param results Where to write the values of the functions, where
+   *   results[f * words + w] holds the value of the f-th function in
+   *   assignments 64 * w to 64 * w + 63.
+   */
+  void evaluate(const std::uint64_t* assignments, std::size_t words,
+                std::uint64_t* results) const;
+};
+
+}
+
+#endif // BATCH_EVALUATOR_H
@@ -0,0 +1,95 @@
+#ifndef BDD_BACKEND_H
+#define BDD_BACKEND_H
+
+#include <string>
+#include <vector>
+
+#include <cuddObj.hh>
+
+#include "Quantification.h"
+
+namespace Syft {
+
+class VarMgr;
+
+/**
+ * \brief The BDD packages that can solve the fixpoints of the games.
+ *
+ * CUDD holds all the BDDs of MtSyft and is always available. Sylvan is a
+ * multi-core package, only available if MtSyft is built with SYFT_WITH_SYLVAN.
+ */
+enum class BddBackendKind {
+  Cudd,
+  Sylvan
+};
+
+std::string to_string(BddBackendKind backend);
+
+/**
+ * \brief Returns the backend named \a name (cudd or sylvan).
+ *
+ * Throws an exception if the name is unknown.
+ */
+BddBackendKind bdd_backend_from_string(const std::string& name);
+
+/**
+ * \brief Returns whether the package was compiled in.
+ */
+bool bdd_backend_available(BddBackendKind backend);
+
+/**
+ * \brief A reachability game, as needed by its fixpoint.
+ *
+ * All the BDDs belong to the CUDD manager of the VarMgr of the game.
+ */
+struct ReachabilityArena {
+  CUDD::BDD goal_states;
+  CUDD::BDD state_space;
+  std::vector<CUDD::BDD> transition_vector;          // as for VectorCompose
+  std::vector<int> initial_vector;                   // as for Eval
+  std::vector<Quantifier> preimage_quantifiers;      // variables the outputs
+                                                     // do not depend on
+  std::vector<Quantifier> projection_quantifiers;    // other non-state
+                                                     // variables
+};
+
+/**
+ * \brief The result of a reachability fixpoint.
+ */
+struct ReachabilityFixpoint {
+  CUDD::BDD winning_moves;
+  CUDD::BDD winning_states;
+  bool includes_initial_state = false;
+};
+
+/**
+ * \brief Computes the moves and states from which the protagonist of \a arena
+ * reaches the goal states, stopping as soon as the initial state is winning.
+ *
+ * The fixpoint runs on the BDD package selected in \a var_mgr. With Sylvan,
+ * the arena is copied into Sylvan, whose operations use all cores, and the
+ * result is copied back into CUDD, where strategies are extracted. The deadline
+ * of \a var_mgr is checked at each iteration, but single Sylvan operations
+ * cannot be interrupted.
+ */
+ReachabilityFixpoint solve_reachability(const VarMgr& var_mgr,
+                                        const ReachabilityArena& arena);
+
+/**
+ * \brief Computes the same fixpoint as solve_reachability for an arena whose
+ * quantifiers are all existential, as in cooperative games.
+ *
+ * Each iteration computes the preimage of the states won at the previous one
+ * only, and conjoins it with the states that are not winning yet while
+ * abstracting the quantified variables in single AndAbstract passes, one for
+ * the moves and one for the states, instead of composing, conjoining and
+ * projecting all the winning moves separately.
+ *
+ * Throws an exception if a quantifier of \a arena is universal.
+ */
+ReachabilityFixpoint solve_cooperative_reachability(
+    const VarMgr& var_mgr, const ReachabilityArena& arena);
+
+}
+
+#endif // BDD_BACKEND_H
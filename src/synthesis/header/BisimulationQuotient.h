@@ -0,0 +1,131 @@
+#ifndef BISIMULATION_QUOTIENT_H
+#define BISIMULATION_QUOTIENT_H
+
+#include <vector>
+
+#include <cuddObj.hh>
+
+#include "SymbolicStateDfa.h"
+#include "Synthesizer.h"
+
+namespace Syft {
+
+/**
+ * \brief A symbolic-state DFA reduced to its reachable states modulo
+ * bisimulation, together with the translation of state sets between the two.
+ *
+ * Two states are bisimilar when they agree on a given set of labels, i.e.,
+ * sets of states such as the final states of the components of a product,
+ * and, for every letter, their successors are bisimilar. The games whose
+ * goals are unions of labels (and their complements, conjunctions, ...) have
+ * the same solution on the quotient as on the original DFA, and so do the
+ * games on components that only depend on their own final states, like the
+ * negated environment games of the chain synthesizers.
+ *
+ * The classes are computed by signature-based partition refinement: each
+ * round maps every state to its signature, the function from letters to the
+ * blocks of its successors, and splits the blocks whose states have different
+ * signatures, until no block is split. The quotient then has one state per
+ * block, encoded in a logarithmic number of fresh state variables.
+ */
+class BisimulationQuotient {
+ private:
+
+  SymbolicStateDfa original_;
+  SymbolicStateDfa quotient_;
+  bool identity_;
+  std::size_t block_count_ = 0;
+  CUDD::BDD reachable_states_;        // over the original state variables
+  CUDD::BDD original_state_cube_;
+  std::vector<CUDD::BDD> block_code_; // bit i of the block of each state
+  CUDD::BDD code_relation_;           // reachable states and their block
+
+  BisimulationQuotient(const SymbolicStateDfa& original,
+                       const SymbolicStateDfa& quotient,
+                       bool identity);
+
+ public:
+
+  /**
+   * \brief Minimizes \a dfa modulo bisimulation.
+   *
+   * \param dfa The DFA to minimize.
+   * \param labels Sets of states, as BDDs over the state variables of \a dfa,
+   *   that must be unions of classes. The final states of \a dfa are always
+   *   included, and the initial state is kept in a class of its own, which is
+   *   encoded as state 0 of the quotient.
+   * \return The quotient of \a dfa, whose transition function depends on the
+   *   same letters.
+   */
+  static BisimulationQuotient minimize(const SymbolicStateDfa& dfa,
+                                       const std::vector<CUDD::BDD>& labels);
+
+  /**
+   * \brief Wraps \a dfa without minimizing it, so that the translations are
+   * the identity.
+   */
+  static BisimulationQuotient identity(const SymbolicStateDfa& dfa);
+
+  /**
+   * \brief Returns the DFA to solve games on: the quotient, or the original
+   * DFA if it was not minimized.
+   */
+  const SymbolicStateDfa& dfa() const;
+
+  /**
+   * \brief Returns the DFA that was minimized.
+   */
+  const SymbolicStateDfa& original() const;
+
+  /**
+   * \brief Returns whether the DFA was minimized.
+   */
+  bool minimized() const;
+
+  /**
+   * \brief Returns the number of classes, i.e., of states of the quotient.
+   */
+  std::size_t block_count() const;
+
+  /**
+   * \brief Returns the number of reachable states of the original DFA.
+   */
+  double reachable_state_count() const;
+
+  /**
+   * \brief Translates a set of states of the original DFA, which must be a
+   * union of classes, into the set of states of the quotient.
+   */
+  CUDD::BDD to_quotient(const CUDD::BDD& states) const;
+
+  /**
+   * \brief Translates a set of states of the quotient into the set of
+   * reachable states of the original DFA in its classes.
+   *
+   * The BDD may also depend on named variables, as output functions do.
+   */
+  CUDD::BDD from_quotient(const CUDD::BDD& states) const;
+
+  /**
+   * \brief Translates the result of a game solved on dfa() into a result on
+   * the original DFA.
+   *
+   * The winning states and the output function of the strategy are
+   * translated, and the strategy follows the transitions of the original DFA.
+   */
+  SynthesisResult from_quotient(SynthesisResult result) const;
+
+  /**
+   * \brief Returns the quotient of the restriction of the original DFA to
+   * the complement of \a invalid_states, as by
+   * SymbolicStateDfa::get_restriction.
+   *
+   * \param invalid_states A union of classes, over the original state
+   *   variables.
+   */
+  BisimulationQuotient restriction(const CUDD::BDD& invalid_states) const;
+};
+
+}
+
+#endif // BISIMULATION_QUOTIENT_H
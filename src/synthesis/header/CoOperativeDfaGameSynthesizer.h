@@ -5,6 +5,8 @@
 #ifndef CO_OP_DFA_GAME_SYNTHESIZER_H
 #define CO_OP_DFA_GAME_SYNTHESIZER_H
 
+#include"BddBackend.h"
+#include"GameArena.h"
 #include"Quantification.h"
 #include"SymbolicStateDfa.h"
 #include"Synthesizer.h"
@@ -18,22 +20,26 @@ namespace Syft {
             std::shared_ptr<VarMgr> var_mgr_;
             Player starting_player_;
             Player protagonist_player_;
-            std::vector<int> initial_vector_;
-            std::vector<CUDD::BDD> transition_vector_;
-            std::unique_ptr<Quantification> quantify_independent_variables_;
-            std::unique_ptr<Quantification> quantify_non_state_variables_;
+            std::shared_ptr<const GameArena> arena_;
+            std::shared_ptr<const Quantification> quantify_independent_variables_;
+            std::shared_ptr<const Quantification> quantify_non_state_variables_;
 
             CUDD::BDD preimage(const CUDD::BDD &winning_states) const;  // Used to compute function t in symbolic synthesis
 
             CUDD::BDD project_into_states(const CUDD::BDD &winning_moves) const;    // Used to compute function w in symbolic synthesis
 
-            std::unordered_map<int, CUDD::BDD> synthesize_strategy(const CUDD::BDD &winning_moves) const;
+            std::unordered_map<int, CUDD::BDD> synthesize_strategy(const CUDD::BDD &winning_moves) const;  // One winning move per state, preferring outputs set to 0
 
             bool includes_initial_state(const CUDD::BDD &winning_states) const;
 
+            ReachabilityArena reachability_arena(const CUDD::BDD &goal_states, const CUDD::BDD &state_space) const;  // Used to solve the game with solve_cooperative_reachability
+
             public:
                 CoOperativeDfaGameSynthesizer(SymbolicStateDfa spec, Player starting_player, Player protagonist_player);
 
+                // Shares the vectors, cubes and quantifiers of arena with the other games on it
+                CoOperativeDfaGameSynthesizer(std::shared_ptr<const GameArena> arena, Player starting_player, Player protagonist_player);
+
                 virtual SynthesisResult run()
                     const override = 0;
     };
@@ -9,10 +9,15 @@
 #include"SymbolicStateDfa.h"
 #include"InputOutputPartition.h"
 #include"ReachabilitySynthesizer.h"
+#include"IndependentSubgameSynthesizer.h"
 #include"CoOperativeReachabilitySynthesizer.h"
 #include"Player.h"
 #include"spotparser.h"
 #include"Stopwatch.h"
+#include"TierSolver.h"
+#include"EnvironmentCache.h"
+#include"BisimulationQuotient.h"
+#include"HybridArenaBuilder.h"
 
 namespace Syft {
 
@@ -27,14 +32,36 @@ namespace Syft {
 
             Player starting_player_;
 
-            std::vector<std::vector<SymbolicStateDfa>> symbolic_dfas_;
+            std::vector<std::vector<SymbolicStateDfa>> symbolic_dfas_; // goal, environment DFAs and tautology of each arena
+            std::vector<std::vector<std::string>> environments_; // formulas of the environment DFAs of each arena, as cache keys
             std::vector<SymbolicStateDfa> arena_;
-            std::vector<SymbolicStateDfa> restricted_arena_;
+            std::vector<BisimulationQuotient> quotients_; // arenas the games are solved on
+            std::vector<BisimulationQuotient> restricted_arena_;
 
             Syft::InputOutputPartition partition_;
 
             std::vector<double> run_times_;
 
+            bool timed_out_ = false;
+
+            TierSolving tier_solving_ = TierSolving::All;
+
+            bool minimize_arenas_ = false;
+
+            std::shared_ptr<EnvironmentCache> environment_cache_;
+
+            // translates the specifications and builds the game arenas
+            void construct_arenas();
+
+            // solves the games on the arenas, filling in result
+            void solve_games(ChainedStrategies& result);
+
+            // key of the explicit product of core and conjunct i in the environment cache
+            std::string product_formula(int i) const;
+
+            // final states of the environment of arena i, i.e. the conjunction of those of its environment DFAs
+            CUDD::BDD environment_final_states(int i) const;
+
         public:
 
             CommonCoreChainSynthesizer(
@@ -43,15 +70,25 @@ namespace Syft {
                 std::string env_core,
                 std::vector<std::string> conjuncts,
                 Syft::InputOutputPartition partition,
-                Syft::Player starting_player
+                Syft::Player starting_player,
+                std::shared_ptr<EnvironmentCache> environment_cache = nullptr // shared by synthesizers on the same VarMgr, if given
             );
 
+            // selects which games run() solves (default all of them)
+            void set_tier_solving(TierSolving tier_solving);
+
+            // minimizes the arenas modulo bisimulation before the games (default off)
+            void set_arena_minimization(bool minimize_arenas);
+
             virtual ChainedStrategies run() final;
 
             void realizability(const std::vector<SynthesisResult>& adv_results,
                                  const std::vector<SynthesisResult>& coop_results) const;
 
             std::vector<double> get_run_times() const;
+
+            // whether the deadline of the VarMgr expired during construction or run()
+            bool timed_out() const;
     };
 
 
@@ -0,0 +1,95 @@
+#ifndef CONJUNCTIVE_DFA_H
+#define CONJUNCTIVE_DFA_H
+
+#include <string>
+#include <vector>
+
+#include "EnvironmentCache.h"
+#include "ExplicitStateDfaMona.h"
+#include "SymbolicStateDfa.h"
+
+namespace Syft {
+
+/**
+ * \brief The DFA of an LTLf formula, given by the DFAs of its top-level
+ * conjuncts.
+ *
+ * The explicit DFA of a conjunction is the product of the DFAs of its
+ * conjuncts, which can have many more states than all of them together. In
+ * the decomposed construction, each top-level conjunct is translated on its
+ * own, and the DFAs are only composed once symbolized, by
+ * SymbolicStateDfa::product, whose final states are the conjunction of theirs.
+ * Without decomposition, the formula is translated as a whole, as its only
+ * conjunct.
+ *
+ * The DFAs of the conjuncts are memoized by the normal form of their formulas
+ * (FormulaSimplifier::normal_form) for the whole process, so that repeated
+ * tiers, and conjuncts shared by several tiers or instances, are translated
+ * once. Their symbolic DFAs are memoized in the EnvironmentCache.
+ */
+class ConjunctiveDfa {
+ private:
+
+  std::vector<std::string> formulas_;
+  std::vector<ExplicitStateDfaMona> conjuncts_;
+
+  ConjunctiveDfa(std::vector<std::string> formulas,
+                 std::vector<ExplicitStateDfaMona> conjuncts);
+
+ public:
+
+  /**
+   * \brief Sets whether formulas are translated conjunct-wise (default false).
+   */
+  static void set_decomposition(bool decompose);
+
+  static bool decomposition();
+
+  /**
+   * \brief Sets whether the DFAs of the conjuncts are memoized (default
+   * true).
+   *
+   * Disabling the memoization also clears the memo.
+   */
+  static void set_memoization(bool memoize);
+
+  /**
+   * \brief Returns how many translations the memo has saved.
+   */
+  static std::size_t memo_hits();
+
+  /**
+   * \brief Translates \a formula, conjunct-wise in the decomposed
+   * construction.
+   *
+   * The conjuncts are translated by ExplicitStateDfaMona::dfas_of_formulas,
+   * i.e., in parallel with the MONA backend.
+   */
+  static ConjunctiveDfa of_formula(const std::string& formula);
+
+  /**
+   * \brief Returns the DFAs of the conjuncts.
+   */
+  const std::vector<ExplicitStateDfaMona>& conjuncts() const;
+
+  /**
+   * \brief Returns the names of the variables of all the conjuncts, without
+   * repetitions.
+   */
+  std::vector<std::string> names() const;
+
+  /**
+   * \brief Symbolizes the DFAs of the conjuncts, unless \a cache has them
+   * already, and composes them.
+   *
+   * The named variables of the conjuncts must already exist in the variable
+   * manager of \a cache.
+   *
+   * \return The symbolic DFA of the formula.
+   */
+  SymbolicStateDfa to_symbolic(EnvironmentCache& cache) const;
+};
+
+}
+
+#endif // CONJUNCTIVE_DFA_H
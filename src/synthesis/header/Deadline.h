@@ -0,0 +1,79 @@
+#ifndef DEADLINE_H
+#define DEADLINE_H
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+namespace Syft {
+
+/**
+ * \brief Exception thrown when a computation runs past its deadline.
+ */
+class DeadlineExceeded : public std::runtime_error {
+ public:
+
+  explicit DeadlineExceeded(const std::string& what);
+};
+
+/**
+ * \brief Cancellation token for long computations.
+ *
+ * A deadline expires either when its time limit elapses or when it is
+ * cancelled explicitly, possibly from another thread. Long computations poll
+ * it through \a check, which throws DeadlineExceeded once it has expired.
+ * When attached to a VarMgr, CUDD also polls it during single operations.
+ */
+class Deadline {
+ private:
+
+  std::atomic<bool> cancelled_;
+  bool time_limited_;
+  std::chrono::steady_clock::time_point expiry_;
+
+ public:
+
+  /**
+   * \brief Creates a deadline that only expires when cancelled.
+   */
+  Deadline();
+
+  /**
+   * \brief Creates a deadline that expires \a seconds from now.
+   */
+  explicit Deadline(double seconds);
+
+  /**
+   * \brief Expires the deadline immediately.
+   */
+  void cancel();
+
+  /**
+   * \brief Returns whether the deadline has expired.
+   */
+  bool expired() const;
+
+  /**
+   * \brief Throws DeadlineExceeded if the deadline has expired.
+   */
+  void check() const;
+
+  /**
+   * \brief Termination callback for CUDD.
+   *
+   * \param deadline A pointer to a Deadline.
+   * \return Nonzero if the deadline has expired, which makes CUDD abort the
+   *   current operation.
+   */
+  static int termination_callback(const void* deadline);
+
+  /**
+   * \brief Termination handler for CUDD, throws DeadlineExceeded.
+   */
+  static void termination_handler(std::string message);
+};
+
+}
+
+#endif // DEADLINE_H
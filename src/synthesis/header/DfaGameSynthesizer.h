@@ -1,6 +1,8 @@
 #ifndef DFA_GAME_SYNTHESIZER_H
 #define DFA_GAME_SYNTHESIZER_H
 
+#include "BddBackend.h"
+#include "GameArena.h"
 #include "Quantification.h"
 #include "SymbolicStateDfa.h"
 #include "Synthesizer.h"
@@ -17,10 +19,9 @@ class DfaGameSynthesizer : public Synthesizer<SymbolicStateDfa> {
   std::shared_ptr<VarMgr> var_mgr_;
   Player starting_player_;
   Player protagonist_player_;
-  std::vector<int> initial_vector_;
-  std::vector<CUDD::BDD> transition_vector_;
-  std::unique_ptr<Quantification> quantify_independent_variables_;
-  std::unique_ptr<Quantification> quantify_non_state_variables_;
+  std::shared_ptr<const GameArena> arena_;
+  std::shared_ptr<const Quantification> quantify_independent_variables_;
+  std::shared_ptr<const Quantification> quantify_non_state_variables_;
 
   CUDD::BDD preimage(const CUDD::BDD& winning_states) const;
 
@@ -30,6 +31,13 @@ class DfaGameSynthesizer : public Synthesizer<SymbolicStateDfa> {
       const CUDD::BDD& winning_moves) const;
   
   bool includes_initial_state(const CUDD::BDD& winning_states) const;
+
+  /**
+   * \brief Returns the arena of the reachability game towards \a goal_states
+   * within \a state_space, to be solved by solve_reachability.
+   */
+  ReachabilityArena reachability_arena(const CUDD::BDD& goal_states,
+                                       const CUDD::BDD& state_space) const;
   
  public:
 
@@ -43,6 +51,14 @@ class DfaGameSynthesizer : public Synthesizer<SymbolicStateDfa> {
    */
   DfaGameSynthesizer(SymbolicStateDfa spec, Player starting_player, Player protagonist_player);
 
+  /**
+   * \brief Construct a synthesizer for a DFA game on a shared arena.
+   *
+   * \param arena The game's arena, shared with the other games on it.
+   * \param starting_player The player that moves first each turn.
+   */
+  DfaGameSynthesizer(std::shared_ptr<const GameArena> arena, Player starting_player, Player protagonist_player);
+
 
   /**
    * \brief Computes a winning strategy for the game.
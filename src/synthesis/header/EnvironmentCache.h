@@ -0,0 +1,121 @@
+#ifndef ENVIRONMENT_CACHE_H
+#define ENVIRONMENT_CACHE_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <cuddObj.hh>
+
+#include "ExplicitStateDfaMona.h"
+#include "Player.h"
+#include "SymbolicStateDfa.h"
+#include "VarMgr.h"
+
+namespace Syft {
+
+/**
+ * \brief Symbolic DFAs of environment specifications, and the regions where
+ * the agent can force their violation, shared by the synthesizers that work
+ * on the same VarMgr.
+ *
+ * Whether the agent can force a violation of an environment does not depend
+ * on the goal. The game for the negated environment is thus solved on the
+ * product of the environment DFAs with the DFA of non-empty traces only,
+ * whose state variables are a subset of those of every game arena built from
+ * the same DFAs. The winning region is then valid in all those arenas as is.
+ * Since the DFAs are cached as well, multiple goals solved against the same
+ * tiers reuse both the DFAs and the regions.
+ *
+ * The DFAs are keyed by the normal form of their formulas
+ * (FormulaSimplifier::normal_form), so that formulas that only differ in the
+ * order or repetition of their operands share a DFA, and with it its state
+ * variables.
+ */
+class EnvironmentCache {
+ private:
+
+  std::shared_ptr<VarMgr> var_mgr_;
+  std::unordered_map<std::string, SymbolicStateDfa> dfas_;
+  std::unique_ptr<SymbolicStateDfa> non_empty_traces_dfa_;
+  std::map<std::pair<std::vector<std::string>, Player>, CUDD::BDD> regions_;
+  std::size_t region_hits_ = 0;
+  std::size_t dfa_hits_ = 0;
+
+ public:
+
+  /**
+   * \brief Creates an empty cache for DFAs on the variables of \a var_mgr.
+   */
+  explicit EnvironmentCache(std::shared_ptr<VarMgr> var_mgr);
+
+  /**
+   * \brief Returns the variable manager of the cached DFAs.
+   */
+  std::shared_ptr<VarMgr> var_mgr() const;
+
+  /**
+   * \brief Returns the cached symbolic DFA of \a formula, or nullptr if there
+   * is none.
+   */
+  const SymbolicStateDfa* find_dfa(const std::string& formula) const;
+
+  /**
+   * \brief Caches \a dfa as the symbolic DFA of \a formula.
+   *
+   * \return The cached DFA, which is the one already cached for \a formula,
+   *   if any.
+   */
+  const SymbolicStateDfa& insert_dfa(const std::string& formula,
+                                     SymbolicStateDfa dfa);
+
+  /**
+   * \brief Returns the cached symbolic DFA of \a formula, or nullptr if there
+   * is none, counting a hit as a reuse of the DFA.
+   */
+  const SymbolicStateDfa* reuse_dfa(const std::string& formula);
+
+  /**
+   * \brief Returns the cached symbolic DFA of \a formula, symbolizing
+   * \a explicit_dfa, the DFA of \a formula, if there is none.
+   */
+  const SymbolicStateDfa& symbolic_dfa(const std::string& formula,
+                                       const ExplicitStateDfaMona& explicit_dfa);
+
+  /**
+   * \brief Returns the symbolic DFA accepting non-empty traces only, built on
+   * first use.
+   */
+  const SymbolicStateDfa& non_empty_traces_dfa();
+
+  /**
+   * \brief Returns the states from which the agent can force a violation of
+   * an environment, solving the game on first use.
+   *
+   * \param environment The formulas of the environment, used as key.
+   * \param dfas The symbolic DFAs of the environment, whose conjunction is the
+   *   environment.
+   * \param starting_player The player that moves first each turn.
+   */
+  CUDD::BDD violation_region(const std::vector<std::string>& environment,
+                             const std::vector<SymbolicStateDfa>& dfas,
+                             Player starting_player);
+
+  /**
+   * \brief Returns how many times violation_region found a cached region.
+   */
+  std::size_t region_hits() const;
+
+  /**
+   * \brief Returns how many times reuse_dfa and symbolic_dfa found a cached
+   * DFA.
+   */
+  std::size_t dfa_hits() const;
+};
+
+}
+
+#endif // ENVIRONMENT_CACHE_H
@@ -17,10 +17,15 @@
 #include"SymbolicStateDfa.h"
 #include"InputOutputPartition.h"
 #include"ReachabilitySynthesizer.h"
+#include"IndependentSubgameSynthesizer.h"
 #include"CoOperativeReachabilitySynthesizer.h"
 #include"Player.h"
 #include"spotparser.h"
 #include"Stopwatch.h"
+#include"TierMap.h"
+#include"TierSolver.h"
+#include"EnvironmentCache.h"
+#include"BisimulationQuotient.h"
 
 namespace Syft {
 
@@ -37,11 +42,26 @@ namespace Syft {
 
             std::vector<std::vector<SymbolicStateDfa>> symbolic_dfas_;
             std::vector<SymbolicStateDfa> arena_;
-            std::vector<SymbolicStateDfa> restricted_arena_;
+            std::vector<BisimulationQuotient> quotients_; // arenas the games are solved on
+            std::vector<BisimulationQuotient> restricted_arena_;
 
             Syft::InputOutputPartition partition_;
 
-            std::vector<double> run_times_; 
+            std::vector<double> run_times_;
+
+            bool timed_out_ = false;
+
+            TierSolving tier_solving_ = TierSolving::All;
+
+            bool minimize_arenas_ = false;
+
+            std::shared_ptr<EnvironmentCache> environment_cache_;
+
+            // translates the specifications and builds the game arenas
+            void construct_arenas();
+
+            // solves the games on the arenas, filling in result
+            void solve_games(ChainedStrategies& result); 
         
         public:
             // member functions
@@ -51,9 +71,16 @@ namespace Syft {
                 std::string ltlf_goal,
                 std::vector<std::string> ltlf_envs,
                 Syft::InputOutputPartition partition,
-                Syft::Player starting_player
+                Syft::Player starting_player,
+                std::shared_ptr<EnvironmentCache> environment_cache = nullptr // shared by synthesizers on the same VarMgr, if given
             );
 
+            // selects which games run() solves (default all of them)
+            void set_tier_solving(TierSolving tier_solving);
+
+            // minimizes the arenas modulo bisimulation before the games (default off)
+            void set_arena_minimization(bool minimize_arenas);
+
             // DFA game solving
             // virtual std::pair<std::vector<SynthesisResult>, std::vector<SynthesisResult>> run() final;
             virtual ChainedStrategies run() final;
@@ -69,6 +96,9 @@ namespace Syft {
 
             std::vector<double> get_run_times() const;
 
+            // whether the deadline of the VarMgr expired during construction or run()
+            bool timed_out() const;
+
             // std::shared_ptr<Syft::VarMgr> get_mgr() const;
 
 
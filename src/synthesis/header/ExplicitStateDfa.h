@@ -2,9 +2,8 @@
 #define EXPLICIT_STATE_DFA_H
 
 #include <exception>
-#include <istream>
 #include <memory>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
 #include "VarMgr.h"
@@ -33,37 +32,8 @@ class ExplicitStateDfa {
 
   static std::string safetyltl_to_dfa_file(const std::string& safetyltl_filename);
 
-  static std::vector<std::string> read_mona_line(std::istream& in,
-						 std::size_t line_number);
-
-  static std::vector<std::string> read_variable_names(std::istream& in,
-						      std::size_t line_number);
-  
-  static std::size_t read_state_count(std::istream& in,
-				      std::size_t line_number);
-
-  static std::vector<std::size_t> read_final_states(std::istream& in,
-						    std::size_t line_number);
-
-  static std::vector<std::size_t> read_behaviour(std::istream& in,
-						 std::size_t line_number);
-
-  static std::vector<std::vector<int>> read_node_table(std::istream& in,
-						       std::size_t line_number);
-
-  static CUDD::ADD build_add(
-      std::size_t node_index,
-      const std::shared_ptr<VarMgr>& var_mgr,
-      const std::vector<std::string>& variable_names,
-      const std::vector<std::vector<int>>& node_table,
-      std::unordered_map<std::size_t, CUDD::ADD>& add_table);
-
-    static CUDD::ADD build_add_from_dfa_mona(
-            unsigned node_index,
-            const std::shared_ptr<VarMgr>& var_mgr,
-            const std::vector<std::string>& variable_names,
-            const ExplicitStateDfaMona& explicit_dfa,
-            std::unordered_map<std::size_t, CUDD::ADD>& add_table);
+  static ExplicitStateDfa parse_mona_dfa(std::shared_ptr<VarMgr> var_mgr,
+                                         std::string_view contents);
 
  public:
 
@@ -74,6 +44,9 @@ class ExplicitStateDfa {
    * dummy initial state with a transition to state 1. State 1 is set as the
    * initial state in the returned DFA.
    *
+   * The file is mapped in memory and parsed in place, and the BDD of MONA is
+   * translated into ADDs iteratively, visiting each node once.
+   *
    * \param var_mgr The variable manager for managing transition variables.
    * \param filename The name of the file to read the DFA from.
    * \return The DFA described in the file.
@@ -112,14 +85,14 @@ class ExplicitStateDfa {
   /**
    * \brief Returns the list of indices of final states of the DFA.
    */
-  std::vector<std::size_t> final_states() const;
+  const std::vector<std::size_t>& final_states() const;
 
   /**
    * \brief Returns the transition function of the DFA as a vector of ADDs.
    *
    * The ADD in index \a i represents the transition function for state \a i.
    */
-  std::vector<CUDD::ADD> transition_function() const;
+  const std::vector<CUDD::ADD>& transition_function() const;
 
   /**
    * \brief Saves the transition function of the DFA in a .dot file.
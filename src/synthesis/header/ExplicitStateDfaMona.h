@@ -13,8 +13,31 @@ extern "C" {
 
 #include "lydia/dfa/mona_dfa.hpp"
 
+#include <string>
+#include <vector>
+
 namespace Syft {
 
+/**
+ * \brief How LTLf formulas are translated into DFAs.
+ *
+ * Lydia builds the DFA compositionally, from the DFAs of the subformulas.
+ * MONA translates the first-order encoding of the formula (as by ltlf2fol) as
+ * a whole, which can be faster, e.g., for long chains of nested next
+ * operators over few propositions.
+ */
+enum class TranslationBackend {
+    Lydia,
+    Mona
+};
+
+std::string to_string(TranslationBackend backend);
+
+/**
+ * \brief Returns the backend named \a name, i.e., "lydia" or "mona".
+ */
+TranslationBackend translation_backend_from_string(const std::string& name);
+
 /*
  * Wrapper to Lydia DFA.
  */
@@ -72,8 +95,11 @@ namespace Syft {
         /**
          * \brief Take the product of a vector of DFAs.
          *
+         * The DFAs are multiplied smallest first, minimizing each product.
+         * Calls from different threads are serialized, as for dfa_of_formula.
+         *
          * \param dfa_vector The DFAs to be processed.
-         * \return The product DFA.
+         * \return The product DFA, accepting the conjunction.
          */
         static ExplicitStateDfaMona dfa_product(const std::vector<ExplicitStateDfaMona>& dfa_vector);
 
@@ -105,14 +131,64 @@ namespace Syft {
         /**
          * \brief Construct DFA from a given formula
          *
+         * The formula is translated with the backend set by
+         * set_translation_backend, Lydia by default.
          *
          * \param formula An LTLf formula.
          * \return The corresponding explicit-state DFA.
          */
         static ExplicitStateDfaMona dfa_of_formula(const std::string& formula);
 
+        /**
+         * \brief Construct DFA from a given formula with the given backend
+         *
+         * With TranslationBackend::Mona, the formula is translated into a MONA
+         * program in process and the DFA produced by MONA is read from a pipe,
+         * without intermediate files. Lydia's last and end are not supported.
+         * Calls from different threads are serialized.
+         *
+         * \param formula An LTLf formula.
+         * \param backend The translation backend.
+         * \return The corresponding explicit-state DFA.
+         */
+        static ExplicitStateDfaMona dfa_of_formula(const std::string& formula,
+                                                   TranslationBackend backend);
+
+        /**
+         * \brief Construct the DFAs of several formulas
+         *
+         * The formulas are translated with the backend set by
+         * set_translation_backend. With TranslationBackend::Mona, the MONA
+         * processes of up to one formula per core run at the same time, and
+         * their DFAs are imported one at a time; Lydia translates the
+         * formulas one after the other.
+         *
+         * \param formulas LTLf formulas.
+         * \return The corresponding explicit-state DFAs, in the same order.
+         */
+        static std::vector<ExplicitStateDfaMona> dfas_of_formulas(const std::vector<std::string>& formulas);
+
+        /**
+         * \brief Sets the backend used by dfa_of_formula(formula).
+         */
+        static void set_translation_backend(TranslationBackend backend);
+
+        static TranslationBackend translation_backend();
+
+        /**
+         * \brief Construct the DFA of F(true), i.e. accepting all non-empty traces
+         *
+         * The formula is translated only once, later calls return a copy.
+         *
+         * \return The explicit-state DFA of F(true).
+         */
+        static ExplicitStateDfaMona dfa_of_non_empty_traces();
+
+    private:
 
+        static ExplicitStateDfaMona dfa_of_formula_lydia(const std::string& formula);
 
+        static ExplicitStateDfaMona dfa_of_formula_mona(const std::string& formula);
 
     };
 
@@ -0,0 +1,84 @@
+#ifndef FORMULA_SIMPLIFIER_H
+#define FORMULA_SIMPLIFIER_H
+
+#include <string>
+#include <vector>
+
+namespace Syft {
+
+/**
+ * \brief The result of simplifying an LTLf formula.
+ */
+struct FormulaSimplification {
+  std::string formula;             // the formula to translate
+  std::size_t original_size = 0;   // nodes of the parsed formula
+  std::size_t simplified_size = 0; // nodes of the simplified formula
+  bool parsed = false;             // false if the formula was left as is
+};
+
+/**
+ * \brief Rewrites LTLf formulas into smaller equivalent ones before they are
+ * translated into DFAs.
+ *
+ * The rewriting preserves the semantics on finite traces:
+ *
+ * - constants are folded, e.g., a && ff = ff and a U tt = tt. The
+ *   propositional true is only folded into tt where the trace is known to
+ *   have a position, e.g., X(true) = X(tt) and a && true = a, since it does
+ *   not hold on the empty trace, so that F(true) stays as is;
+ * - nested conjunctions and disjunctions are flattened, and duplicate and
+ *   complementary operands are eliminated, e.g., a && b && a = a && b and
+ *   a || !a = tt;
+ * - implications are eliminated and negations are pushed inwards, through the
+ *   boolean connectives and the dualities of G/F, U/R and W;
+ * - idempotent temporal operators are collapsed, e.g., G G a = G a, and
+ *   conjunctions of G (disjunctions of F) are merged into a single G (F).
+ *
+ * Since X is strong in some LTLf tools and weak in others, the next operators
+ * are kept as written, and so are the negations in front of them. Formulas
+ * that simplify to true are written as "tt", so that all the trivial tiers of
+ * a specification share a single DFA.
+ *
+ * The syntax is that of the specification files, i.e., the LTLf syntax of
+ * Lydia and ltlf2fol. Formulas that do not parse, e.g., LDLf formulas, are
+ * left as is.
+ */
+class FormulaSimplifier {
+ public:
+
+  /**
+   * \brief Simplifies \a formula.
+   *
+   * \return The simplified formula and the number of nodes of the syntax tree
+   *   of the formula before and after the simplification.
+   */
+  static FormulaSimplification simplify(const std::string& formula);
+
+  /**
+   * \brief Splits \a formula into its top-level conjuncts.
+   *
+   * Nested conjunctions are flattened and duplicate conjuncts are dropped, but
+   * the conjuncts are not simplified. A formula that is not a conjunction, or
+   * that does not parse, is its only conjunct.
+   */
+  static std::vector<std::string> top_level_conjuncts(
+      const std::string& formula);
+
+  /**
+   * \brief Returns a normal form of \a formula, as a key for the DFAs of
+   * equivalent formulas.
+   *
+   * The operands of conjunctions, disjunctions and equivalences are sorted,
+   * nested conjunctions and disjunctions are flattened and repeated operands
+   * are dropped, so that, e.g., "b && (a && b)" and "a && b" have the same
+   * normal form. The constants are spelled in one way, but tt and ff are kept
+   * apart from true and false, which do not hold on the empty trace. The
+   * formula is not simplified otherwise. A formula that does not parse is its
+   * own normal form.
+   */
+  static std::string normal_form(const std::string& formula);
+};
+
+}
+
+#endif // FORMULA_SIMPLIFIER_H
@@ -0,0 +1,91 @@
+#ifndef GAME_ARENA_H
+#define GAME_ARENA_H
+
+#include <memory>
+#include <vector>
+
+#include <cuddObj.hh>
+
+#include "Player.h"
+#include "Quantification.h"
+#include "SymbolicStateDfa.h"
+
+namespace Syft {
+
+/**
+ * \brief The quantifications of the preimage and the projection of a game.
+ */
+struct GameQuantification {
+  // variables that the moves of the protagonist do not depend on
+  std::shared_ptr<const Quantification> independent_variables;
+  // the other non-state variables
+  std::shared_ptr<const Quantification> non_state_variables;
+};
+
+/**
+ * \brief The arena of DFA games, with what the games on it need computed
+ * once.
+ *
+ * The initial state as needed by Eval, the transition function as needed by
+ * VectorCompose, the input and output cubes and the quantifications of every
+ * kind of game do not depend on the goal, but their construction is linear in
+ * the number of variables and automata of the VarMgr. The synthesizers built
+ * on the same GameArena, e.g., the adversarial games of all the tiers of
+ * conj-MtSyft or the adversarial and negated environment games of best-effort
+ * synthesis, share them.
+ */
+class GameArena {
+ private:
+
+  SymbolicStateDfa dfa_;
+  std::vector<int> initial_vector_;
+  std::vector<CUDD::BDD> transition_vector_;
+  CUDD::BDD input_cube_;
+  CUDD::BDD output_cube_;
+  // by starting player, protagonist player and cooperation, see quantification
+  std::vector<GameQuantification> quantifications_;
+
+ public:
+
+  /**
+   * \brief Computes the vectors, cubes and quantifications of the games on
+   * \a dfa.
+   */
+  explicit GameArena(SymbolicStateDfa dfa);
+
+  /**
+   * \brief Returns the DFA of the arena.
+   */
+  const SymbolicStateDfa& dfa() const;
+
+  /**
+   * \brief Returns the initial state, as needed by CUDD::BDD::Eval.
+   */
+  const std::vector<int>& initial_vector() const;
+
+  /**
+   * \brief Returns the transition function, as needed by
+   * CUDD::BDD::VectorCompose.
+   */
+  const std::vector<CUDD::BDD>& transition_vector() const;
+
+  const CUDD::BDD& input_cube() const;
+
+  const CUDD::BDD& output_cube() const;
+
+  /**
+   * \brief Returns the quantifications of the games on the arena.
+   *
+   * \param starting_player The player that moves first each turn.
+   * \param protagonist_player The player whose winning region is computed.
+   * \param cooperative Whether the other player helps the protagonist, so
+   *   that all the variables are quantified existentially.
+   */
+  const GameQuantification& quantification(Player starting_player,
+                                           Player protagonist_player,
+                                           bool cooperative) const;
+};
+
+}
+
+#endif // GAME_ARENA_H
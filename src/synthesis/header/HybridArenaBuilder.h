@@ -0,0 +1,53 @@
+#ifndef HYBRID_ARENA_BUILDER_H
+#define HYBRID_ARENA_BUILDER_H
+
+#include <vector>
+
+#include "ExplicitStateDfaMona.h"
+
+namespace Syft {
+
+/**
+ * \brief Multiplies small DFAs explicitly before symbolizing them.
+ *
+ * The symbolic product of DFAs encodes each component in its own state
+ * variables, so the unreachable and equivalent combinations of their states
+ * stay in the arena. The explicit product of small DFAs, minimized by MONA,
+ * has none of them and is encoded in fewer state variables.
+ *
+ * Only DFAs whose final states are used in conjunction, e.g., the core and a
+ * conjunct of an environment, can be multiplied this way, since the product
+ * accepts the conjunction. The blocks are then symbolized separately, and
+ * their final states conjoined in place of those of the original DFAs.
+ */
+class HybridArenaBuilder {
+ public:
+
+  /**
+   * \brief Sets the largest number of states of an explicit product, as the
+   * product of the state counts of its factors (default 0, i.e., DFAs are
+   * never multiplied explicitly).
+   */
+  static void set_state_budget(std::size_t state_budget);
+
+  static std::size_t state_budget();
+
+  /**
+   * \brief Repeatedly multiplies the two smallest DFAs and minimizes the
+   * product, as long as the product of their state counts is within
+   * \a state_budget.
+   *
+   * \param conjuncts The DFAs of a conjunction.
+   * \param state_budget The largest product of the state counts of two DFAs
+   *   to multiply.
+   * \return The blocks, i.e., the minimized products of disjoint sets of
+   *   \a conjuncts, whose conjunction is that of \a conjuncts.
+   */
+  static std::vector<ExplicitStateDfaMona> multiply(
+      const std::vector<ExplicitStateDfaMona>& conjuncts,
+      std::size_t state_budget);
+};
+
+}
+
+#endif // HYBRID_ARENA_BUILDER_H
@@ -0,0 +1,101 @@
+#ifndef INDEPENDENT_SUBGAME_SYNTHESIZER_H
+#define INDEPENDENT_SUBGAME_SYNTHESIZER_H
+
+#include <vector>
+
+#include "DfaGameSynthesizer.h"
+
+namespace Syft {
+
+/**
+ * \brief A synthesizer for a reachability game on a product of DFAs, whose
+ * goal is a disjunction of goals of the single DFAs, that solves the game as
+ * independent subgames when the DFAs allow it.
+ *
+ * The DFAs of the product are grouped into clusters whose transitions share no
+ * input or output variable. The DFAs whose transitions read no input or output
+ * variable, e.g., the DFA of non-empty traces, belong to every cluster. The
+ * game is then won from a state iff one of the subgames, on the product of the
+ * DFAs of a cluster towards the disjunction of their goals, is won from it:
+ * the opponent can keep each cluster out of its goal on its own variables. The
+ * strategy plays the moves of the first subgame that is won, which keeps
+ * winning it until its goal is reached.
+ *
+ * The subgames are solved one at a time, stopping once one of them is won from
+ * the initial state, and the subgames whose goal is empty are skipped.
+ */
+class IndependentSubgameSynthesizer : public DfaGameSynthesizer {
+ private:
+
+  std::vector<SymbolicStateDfa> components_;
+  std::vector<CUDD::BDD> goal_terms_;
+  CUDD::BDD guard_;
+  std::vector<std::vector<std::size_t>> clusters_;
+  std::vector<std::size_t> shared_components_;
+  bool decomposable_ = false;
+
+  void find_clusters();
+
+  bool depends_only_on(const CUDD::BDD& bdd,
+                       const std::vector<std::size_t>& components) const;
+
+ public:
+
+  /**
+   * \brief Sets whether the chain synthesizers look for independent subgames
+   * in their adversarial games (default false).
+   */
+  static void set_subgame_detection(bool detect_subgames);
+
+  static bool subgame_detection();
+
+  /**
+   * \brief Constructs a synthesizer for the reachability game on \a arena
+   * towards the states where some DFA of \a components is in its goal, and
+   * \a guard holds.
+   *
+   * \param arena The product of \a components, shared with the other games
+   *   on it.
+   * \param components The DFAs of the product, possibly repeated.
+   * \param goal_terms For each DFA, its goal, on its state variables.
+   * \param guard A condition on the state variables of the DFAs whose
+   *   transitions read no input or output variable, e.g., the final states of
+   *   the DFA of non-empty traces, to exclude the initial state.
+   * \param starting_player The player that moves first each turn.
+   * \param protagonist_player The player that must reach the goal.
+   */
+  IndependentSubgameSynthesizer(std::shared_ptr<const GameArena> arena,
+                                std::vector<SymbolicStateDfa> components,
+                                std::vector<CUDD::BDD> goal_terms,
+                                CUDD::BDD guard,
+                                Player starting_player,
+                                Player protagonist_player);
+
+  /**
+   * \brief Returns whether the game splits into at least two subgames, and
+   * the goal into goals of the subgames.
+   *
+   * If not, the game should be solved as a whole, e.g., by a
+   * ReachabilitySynthesizer.
+   */
+  bool decomposable() const;
+
+  /**
+   * \brief Returns the number of subgames.
+   */
+  std::size_t subgame_count() const;
+
+  /**
+   * \brief Solves the subgames and combines their results.
+   *
+   * \return The result consists of
+   * realizability
+   * the union of the winning states of the subgames
+   * a transducer representing a winning strategy.
+   */
+  virtual SynthesisResult run() const final;
+};
+
+}
+
+#endif // INDEPENDENT_SUBGAME_SYNTHESIZER_H
@@ -0,0 +1,129 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace Syft {
+
+/**
+ * \brief Collects the profiling spans of the process.
+ *
+ * Profiling is disabled by default, in which case a span costs a relaxed
+ * atomic load. Once enabled, every ProfileSpan that ends is recorded with its
+ * thread and its start and duration in microseconds, and the spans can be
+ * written in the trace-event format of Chrome, which trace viewers such as
+ * chrome://tracing and Perfetto display as nested timelines per thread.
+ */
+class Profiler {
+ private:
+
+  static inline std::atomic<bool> enabled_{false};
+
+  friend class ProfileSpan;
+
+  static void record(const char* name, const char* category,
+                     const char* arg_name, long arg_value,
+                     std::chrono::steady_clock::time_point start,
+                     std::chrono::steady_clock::time_point end);
+
+ public:
+
+  /**
+   * \brief Starts recording the spans that begin from now on.
+   */
+  static void enable();
+
+  /**
+   * \brief Stops recording spans. The spans recorded so far are kept.
+   */
+  static void disable();
+
+  /**
+   * \brief Returns whether spans are being recorded.
+   */
+  static bool enabled() {
+    return enabled_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * \brief Discards the spans recorded so far.
+   */
+  static void clear();
+
+  /**
+   * \brief Returns the number of spans recorded so far.
+   */
+  static std::size_t span_count();
+
+  /**
+   * \brief Writes the spans recorded so far as a Chrome trace-event JSON
+   * document.
+   */
+  static void write_chrome_trace(std::ostream& out);
+
+  /**
+   * \brief Writes the spans recorded so far to \a filename as a Chrome
+   * trace-event JSON document.
+   *
+   * Throws an exception if the file cannot be written.
+   */
+  static void write_chrome_trace(const std::string& filename);
+};
+
+/**
+ * \brief A profiling span that lasts from its construction to the end of its
+ * scope.
+ *
+ * Spans opened while another span of the same thread is open are nested in
+ * it. The name, category and argument name must outlive the profiler, e.g.,
+ * be string literals, since they are recorded by pointer.
+ */
+class ProfileSpan {
+ private:
+
+  const char* name_;
+  const char* category_;
+  const char* arg_name_;
+  long arg_value_;
+  bool active_;
+  std::chrono::steady_clock::time_point start_;
+
+ public:
+
+  /**
+   * \brief Opens a span named \a name in \a category.
+   */
+  explicit ProfileSpan(const char* name, const char* category = "syft")
+    : ProfileSpan(name, category, nullptr, 0) {}
+
+  /**
+   * \brief Opens a span that also records the integer argument \a arg_name,
+   * e.g., the tier of a game or the index of a fixpoint iteration.
+   */
+  ProfileSpan(const char* name, const char* category, const char* arg_name,
+              long arg_value)
+    : name_(name), category_(category), arg_name_(arg_name),
+      arg_value_(arg_value), active_(Profiler::enabled()) {
+    if (active_) {
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  ProfileSpan(const ProfileSpan&) = delete;
+  ProfileSpan& operator=(const ProfileSpan&) = delete;
+
+  ~ProfileSpan() {
+    if (active_) {
+      Profiler::record(name_, category_, arg_name_, arg_value_, start_,
+                       std::chrono::steady_clock::now());
+    }
+  }
+};
+
+}
+
+#endif // PROFILER_H
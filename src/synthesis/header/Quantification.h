@@ -1,10 +1,20 @@
 #ifndef QUANTIFICATION_H
 #define QUANTIFICATION_H
 
+#include <vector>
+
 #include <cuddObj.hh>
 
 namespace Syft {
 
+/**
+ * \brief A single quantifier over all the variables in a cube.
+ */
+struct Quantifier {
+  bool universal;
+  CUDD::BDD variables;
+};
+
 /**
  * \brief Abstract class representing a quantification operation on BDDs.
  */
@@ -12,6 +22,12 @@ class Quantification {
  public:
   virtual ~Quantification() {}
   virtual CUDD::BDD apply(const CUDD::BDD& bdd) const = 0;
+
+  /**
+   * \brief Returns the quantifiers applied by \a apply, innermost first, so
+   * that other BDD packages can perform the same quantification.
+   */
+  virtual std::vector<Quantifier> quantifiers() const = 0;
 };
 
 /**
@@ -20,6 +36,8 @@ class Quantification {
 class NoQuantification final : public Quantification {
  public:
   CUDD::BDD apply(const CUDD::BDD& bdd) const override;
+
+  std::vector<Quantifier> quantifiers() const override;
 };
 
 /**
@@ -33,6 +51,8 @@ class Forall final : public Quantification {
   Forall(CUDD::BDD universal_variables);
 
   CUDD::BDD apply(const CUDD::BDD& bdd) const override;
+
+  std::vector<Quantifier> quantifiers() const override;
 };
 
 /**
@@ -46,6 +66,8 @@ class Exists final : public Quantification {
   Exists(CUDD::BDD existential_variables);
 
   CUDD::BDD apply(const CUDD::BDD& bdd) const override;
+
+  std::vector<Quantifier> quantifiers() const override;
 };
 
 /**
@@ -61,6 +83,8 @@ class ForallExists final : public Quantification {
 	       CUDD::BDD existential_variables);
 
   CUDD::BDD apply(const CUDD::BDD& bdd) const override;
+
+  std::vector<Quantifier> quantifiers() const override;
 };
 
 
@@ -78,6 +102,8 @@ class ExistsExists final: public Quantification {
                   CUDD::BDD existential_variables_b);
 
     CUDD::BDD apply(const CUDD::BDD &bdd) const override;
+
+    std::vector<Quantifier> quantifiers() const override;
 };
 // END
 
@@ -94,6 +120,8 @@ class ExistsExists final: public Quantification {
                     CUDD::BDD universal_variables);
 
         CUDD::BDD apply(const CUDD::BDD& bdd) const override;
+
+        std::vector<Quantifier> quantifiers() const override;
     };
 
 
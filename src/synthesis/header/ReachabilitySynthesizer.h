@@ -26,6 +26,15 @@ class ReachabilitySynthesizer : public DfaGameSynthesizer {
   ReachabilitySynthesizer(SymbolicStateDfa spec, Player starting_player, Player protagonist_player,
 			  CUDD::BDD goal_states, CUDD::BDD state_space);
 
+  /**
+   * \brief Construct a synthesizer for the given reachability game on a shared
+   * arena.
+   *
+   * \param arena The arena of the game, shared with the other games on it.
+   */
+  ReachabilitySynthesizer(std::shared_ptr<const GameArena> arena, Player starting_player, Player protagonist_player,
+			  CUDD::BDD goal_states, CUDD::BDD state_space);
+
     /**
      * \brief Solves the reachability game.
      *
@@ -6,10 +6,14 @@
 #include"SymbolicStateDfa.h"
 #include"InputOutputPartition.h"
 #include"ReachabilitySynthesizer.h"
+#include"IndependentSubgameSynthesizer.h"
 #include"CoOperativeReachabilitySynthesizer.h"
 #include"Player.h"
 #include"spotparser.h"
 #include"Stopwatch.h"
+#include"TierSolver.h"
+#include"EnvironmentCache.h"
+#include"BisimulationQuotient.h"
 
 namespace Syft {
 
@@ -26,11 +30,26 @@ namespace Syft {
 
             std::vector<SymbolicStateDfa> symbolic_dfas_;
             std::vector<SymbolicStateDfa> arena_;
+            std::vector<BisimulationQuotient> quotients_; // arena the games are solved on, then its restrictions
 
             Syft::InputOutputPartition partition_;
 
             std::vector<double> run_times_;
 
+            bool timed_out_ = false;
+
+            TierSolving tier_solving_ = TierSolving::All;
+
+            bool minimize_arenas_ = false;
+
+            std::shared_ptr<EnvironmentCache> environment_cache_;
+
+            // translates the specifications and builds the game arenas
+            void construct_arenas();
+
+            // solves the games on the arenas, filling in result
+            void solve_games(ChainedStrategies& result);
+
         public:
 
             RefiningEnvironmentsChainSynthesizer(
@@ -39,9 +58,16 @@ namespace Syft {
                 std::vector<std::string> refinements,
                 std::string env_base,
                 Syft::InputOutputPartition partition,
-                Syft::Player starting_player
+                Syft::Player starting_player,
+                std::shared_ptr<EnvironmentCache> environment_cache = nullptr // shared by synthesizers on the same VarMgr, if given
             );
 
+            // selects which games run() solves (default all of them)
+            void set_tier_solving(TierSolving tier_solving);
+
+            // minimizes the arena modulo bisimulation before the games (default off)
+            void set_arena_minimization(bool minimize_arenas);
+
             virtual ChainedStrategies run() final;
 
             void realizability(const std::vector<SynthesisResult>& adv_results,
@@ -49,6 +75,9 @@ namespace Syft {
 
             std::vector<double> get_run_times() const;
 
+            // whether the deadline of the VarMgr expired during construction or run()
+            bool timed_out() const;
+
     };
 
 }
\ No newline at end of file
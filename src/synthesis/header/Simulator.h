@@ -0,0 +1,143 @@
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "BatchEvaluator.h"
+#include "SymbolicStateDfa.h"
+#include "Transducer.h"
+
+namespace Syft {
+
+/**
+ * \brief Runs 64 * words simulations side by side, one per bit.
+ *
+ * The simulator keeps a bit-sliced valuation of all the variables of the
+ * manager, as read by BatchEvaluator: the \a words words of a variable hold
+ * its value in every run. Moves are written into the words of the named
+ * variables, and each step updates the words of the state variables of all
+ * runs at once.
+ */
+class Simulator {
+ protected:
+
+  std::size_t words_;
+  std::vector<int> initial_vector_;
+  std::vector<int> state_variables_;         // by position in the state
+  std::vector<std::uint64_t> valuation_;
+  std::vector<std::uint64_t> next_state_;
+
+  Simulator(const VarMgr& var_mgr, std::size_t automaton_id,
+            std::vector<int> initial_vector, std::size_t words);
+
+  /**
+   * \brief Writes the next state computed by \a transitions into the state
+   * variables.
+   */
+  void advance(const BatchEvaluator& transitions);
+
+ public:
+
+  virtual ~Simulator() {}
+
+  /**
+   * \brief Returns the number of runs simulated at once, i.e., 64 * words.
+   */
+  std::size_t runs() const;
+
+  /**
+   * \brief Returns the number of words per variable.
+   */
+  std::size_t words() const;
+
+  /**
+   * \brief Puts every run back into the initial state.
+   */
+  void reset();
+
+  /**
+   * \brief Returns the words holding the value of the variable with index \a
+   * variable in all runs, where bit k of word w is its value in run 64 * w + k.
+   */
+  std::uint64_t* values(int variable);
+  const std::uint64_t* values(int variable) const;
+
+  /**
+   * \brief Gives random values to \a variables in all runs.
+   */
+  void randomize(const std::vector<int>& variables,
+                 std::mt19937_64& generator);
+};
+
+/**
+ * \brief Simulates runs of a symbolic-state DFA on letters chosen by the
+ * caller.
+ */
+class DfaSimulator : public Simulator {
+ private:
+
+  std::vector<int> letter_variables_;
+  BatchEvaluator transitions_;
+  BatchEvaluator final_states_;
+
+ public:
+
+  DfaSimulator(const SymbolicStateDfa& dfa, std::size_t words = 1);
+
+  /**
+   * \brief Returns the indices of the named variables, which form the letters.
+   */
+  const std::vector<int>& letter_variables() const;
+
+  /**
+   * \brief Reads the letters written into the named variables and moves every
+   * run to its next state.
+   */
+  void step();
+
+  /**
+   * \brief Returns, for each word, the runs whose current state is final.
+   */
+  std::vector<std::uint64_t> accepting() const;
+};
+
+/**
+ * \brief Simulates a strategy against moves of its opponent chosen by the
+ * caller.
+ */
+class StrategySimulator : public Simulator {
+ private:
+
+  std::vector<int> protagonist_variables_;
+  std::vector<int> opponent_variables_;
+  BatchEvaluator outputs_;
+  BatchEvaluator transitions_;
+  std::vector<std::uint64_t> moves_;
+
+ public:
+
+  StrategySimulator(const Transducer& transducer, std::size_t words = 1);
+
+  /**
+   * \brief Returns the indices of the variables the strategy sets.
+   */
+  const std::vector<int>& protagonist_variables() const;
+
+  /**
+   * \brief Returns the indices of the variables the opponent sets.
+   */
+  const std::vector<int>& opponent_variables() const;
+
+  /**
+   * \brief Reads the moves of the opponent written into its variables, writes
+   * the moves of the strategy into the protagonist variables and moves every
+   * run to its next state.
+   */
+  void step();
+};
+
+}
+
+#endif // SIMULATOR_H
@@ -23,6 +23,7 @@ class SymbolicStateDfa {
   std::vector<int> initial_state_;
   CUDD::BDD final_states_;
   std::vector<CUDD::BDD> transition_function_;
+  CUDD::BDD valid_states_; // codes that encode a state
 
   SymbolicStateDfa(std::shared_ptr<VarMgr> var_mgr);
 
@@ -44,8 +45,31 @@ class SymbolicStateDfa {
       std::size_t automaton_id,
       const std::vector<CUDD::ADD>& transition_function);
 
+  static CUDD::BDD codes_below(const std::shared_ptr<VarMgr>& mgr,
+                               std::size_t automaton_id,
+                               std::size_t state_count);
+
+  // Minimizes the transition function and the final states against the
+  // valid states, in the don't-care encoding
+  void restrict_to_valid_states();
+
  public:
 
+  /**
+   * \brief Sets whether the codes that encode no state are don't-cares
+   * (default false).
+   *
+   * When the number of states of an explicit DFA is not a power of two, some
+   * codes of its state variables encode no state. By default they move to
+   * state 0 and are not final. In the don't-care encoding, the transition
+   * function and the final states are instead minimized with
+   * CUDD::BDD::Restrict against the valid codes, which are recorded in
+   * valid_states() and excluded from the state space of the games.
+   */
+  static void set_dont_care_encoding(bool dont_cares);
+
+  static bool dont_care_encoding();
+
   /**
    * \brief Converts an explicit DFA to a symbolic representation.
    *
@@ -87,8 +111,11 @@ class SymbolicStateDfa {
   
   /**
    * \brief Returns the bitvector representing the initial state of the DFA.
+   *
+   * The reference stays valid as long as the DFA, as for final_states() and
+   * transition_function(); copy the result to keep it longer.
    */
-  std::vector<int> initial_state() const;
+  const std::vector<int>& initial_state() const;
 
   /**
    * \brief Returns the BDD representing the initial state of the DFA.
@@ -98,7 +125,7 @@ class SymbolicStateDfa {
   /**
    * \brief Returns the BDD encoding the set of final states.
    */
-  CUDD::BDD final_states() const;
+  const CUDD::BDD& final_states() const;
 
   /**
    * \brief Returns the transition function of the DFA as a vector of BDDs.
@@ -106,7 +133,16 @@ class SymbolicStateDfa {
    * The BDD in index \a i computes the value of state variable \a i in the
    * next step, given the current values of the state and alphabet variables.
    */
-  std::vector<CUDD::BDD> transition_function() const;
+  const std::vector<CUDD::BDD>& transition_function() const;
+
+  /**
+   * \brief Returns the BDD of the codes that encode a state.
+   *
+   * The transition function and the final states are only meaningful on these
+   * codes, which are all the codes unless the DFA was built in the don't-care
+   * encoding. The transitions from valid codes always lead to valid codes.
+   */
+  const CUDD::BDD& valid_states() const;
 
   /**
    * \brief Turns the set of invalid states into a sink.
@@ -144,7 +180,10 @@ class SymbolicStateDfa {
      *
      * \param first_dfa The first DFA.
      * \param second_dfa The second DFA.
-     * \return A symbolic DFA of the product.
+     * \return A symbolic DFA of the product, whose valid states are the
+     *   combinations of valid states of the factors. A state variable of
+     *   several factors, e.g., of a DFA that occurs in two of them, is a
+     *   single bit of the product.
      */
   static SymbolicStateDfa product(const std::vector<SymbolicStateDfa>& dfa_vector);
 
@@ -168,6 +207,23 @@ class SymbolicStateDfa {
                                     std::vector<int> initial_state,
                                     CUDD::BDD final_states,
                                     std::vector<CUDD::BDD> transition_function);                  
+
+  /**
+   * @brief Construct SymbolicStateDfa from explicit data structures, only
+   * \a valid_states of which encode a state
+   *
+   * In the don't-care encoding, the transition function and the final states
+   * are minimized against \a valid_states.
+   *
+   * @param valid_states The codes that encode a state, closed under the
+   *   transition function
+   */
+  static SymbolicStateDfa from_bdds(std::shared_ptr<Syft::VarMgr> var_mgr,
+                                    std::size_t automaton_id,
+                                    std::vector<int> initial_state,
+                                    CUDD::BDD final_states,
+                                    std::vector<CUDD::BDD> transition_function,
+                                    CUDD::BDD valid_states);
 };
 
 }
@@ -0,0 +1,37 @@
+#ifndef SYNTHESIS_MODE_H
+#define SYNTHESIS_MODE_H
+
+#include <string>
+
+namespace Syft {
+
+/**
+ * \brief The multi-tier synthesis algorithm used for a problem.
+ *
+ * The mode determines how the lines of the environment specification are
+ * read:
+ *   Chain        (MtSyft)      E_1, ..., E_n, one tier per line
+ *   CommonBase   (cb-MtSyft)   E_c, E'_1, ..., E'_n (base first)
+ *   Refinements  (conj-MtSyft) E'_1, ..., E'_{n-1}, E_n (base last)
+ */
+enum class SynthesisMode {
+  Chain,
+  CommonBase,
+  Refinements
+};
+
+/**
+ * \brief Returns the name of a mode ("mtsyft", "cb-mtsyft" or "conj-mtsyft").
+ */
+std::string to_string(SynthesisMode mode);
+
+/**
+ * \brief Parses the name of a mode, as returned by \a to_string.
+ *
+ * Throws an exception if \a name is not the name of a mode.
+ */
+SynthesisMode synthesis_mode_from_string(const std::string& name);
+
+}
+
+#endif // SYNTHESIS_MODE_H
@@ -0,0 +1,118 @@
+#ifndef SYNTHESIS_SESSION_H
+#define SYNTHESIS_SESSION_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EnvironmentCache.h"
+#include "InputOutputPartition.h"
+#include "Player.h"
+#include "Synthesizer.h"
+#include "SynthesisMode.h"
+#include "TierSolver.h"
+#include "VarMgr.h"
+
+namespace Syft {
+
+/**
+ * \brief The outcome of synthesis for one goal of a session.
+ */
+struct GoalResult {
+  std::string goal;
+  ChainedStrategies strategies;
+  std::vector<double> run_times;  // ltlf2dfa, dfa2symbolic, adv games, coop games
+  double running_time = 0.0;      // seconds
+};
+
+/**
+ * \brief Returns the realizability of a goal in each tier, as one of A
+ * (realizable), C (cooperatively realizable) and U (unrealizable) per tier,
+ * separated by ';'.
+ */
+std::string realizability_string(const ChainedStrategies& strategies);
+
+/**
+ * \brief Solves many goals against a fixed stack of environment tiers.
+ *
+ * The environment specifications are translated and symbolized once, when
+ * the session is created, and their DFAs are kept in an EnvironmentCache on a
+ * VarMgr that lives as long as the session. Each goal then only needs the
+ * translation of the goal itself and the products with the cached DFAs, and
+ * the regions where the agent can force a violation of a tier are computed
+ * for the first goal that needs them and reused by the following ones.
+ *
+ * The state variables of the goals are not released, so the manager grows
+ * with the number of goals solved.
+ */
+class SynthesisSession {
+ private:
+
+  std::shared_ptr<VarMgr> var_mgr_;
+  std::shared_ptr<EnvironmentCache> environment_cache_;
+  std::vector<std::string> environment_specs_;
+  InputOutputPartition partition_;
+  Player starting_player_;
+  SynthesisMode mode_;
+  TierSolving tier_solving_ = TierSolving::All;
+  bool minimize_arenas_ = false;
+  double setup_time_ = 0.0;
+
+ public:
+
+  /**
+   * \brief Creates a session and translates the environment specifications.
+   *
+   * \param environment_specs The lines of the environment file, read
+   *   according to \a mode.
+   * \param partition The partition of the variables of all goals and tiers.
+   * \param starting_player The player that moves first each turn.
+   * \param mode The multi-tier synthesis algorithm.
+   * \param var_mgr The manager to create the variables in, which must have no
+   *   partition yet, e.g., to set a deadline or a memory limit.
+   */
+  SynthesisSession(std::vector<std::string> environment_specs,
+                   InputOutputPartition partition,
+                   Player starting_player,
+                   SynthesisMode mode,
+                   std::shared_ptr<VarMgr> var_mgr = std::make_shared<VarMgr>());
+
+  /**
+   * \brief Selects which games are solved for each goal (default all).
+   */
+  void set_tier_solving(TierSolving tier_solving);
+
+  /**
+   * \brief Selects whether the arenas are minimized modulo bisimulation
+   * before the games (default not).
+   */
+  void set_arena_minimization(bool minimize_arenas);
+
+  /**
+   * \brief Returns the variable manager shared by all goals.
+   */
+  std::shared_ptr<VarMgr> var_mgr() const;
+
+  /**
+   * \brief Returns the cache of environment DFAs and restrictions.
+   */
+  const EnvironmentCache& environment_cache() const;
+
+  /**
+   * \brief Returns the time in seconds spent translating and symbolizing the
+   * environment specifications.
+   */
+  double setup_time() const;
+
+  /**
+   * \brief Solves the games for \a goal under every tier.
+   *
+   * A deadline attached to the variable manager applies to this goal only if
+   * set right before the call.
+   */
+  GoalResult synthesize(const std::string& goal);
+};
+
+}
+
+#endif // SYNTHESIS_SESSION_H
@@ -17,6 +17,7 @@ namespace Syft {
       bool truncate;
       std::vector<SynthesisResult> adversarial_results;
       std::vector<SynthesisResult> cooperative_results;
+      bool timed_out = false; // results may be missing for some tiers if true
     };
 
 /**
@@ -0,0 +1,89 @@
+#ifndef TIER_MAP_H
+#define TIER_MAP_H
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "cuddObj.hh"
+
+#include "Synthesizer.h"
+#include "VarMgr.h"
+
+namespace Syft {
+
+/**
+ * \brief The tiers that determine the best-effort move in a state.
+ */
+struct TierSelection {
+  int max_win = -1;   // greatest valid tier whose adversarial game is won
+  int min_coop = -1;  // least tier above max_win whose cooperative game is won
+};
+
+/**
+ * \brief The winning regions and strategies of a chain of tiers, folded into
+ * single diagrams.
+ *
+ * A multi-terminal ADD maps each state of the arena to the greatest tier
+ * whose adversarial game is won from it, the least tier above it whose
+ * cooperative game is won, and the least tier whose cooperative game is won.
+ * Selecting the tiers in a state is then a single evaluation, whatever the
+ * number of tiers.
+ *
+ * The output functions of the strategies are merged in the same way: the
+ * adversarial output function plays, in each state, the strategy of the
+ * greatest tier won adversarially from it, and the cooperative one the
+ * strategy of the least tier won cooperatively.
+ */
+class TierMap {
+ private:
+
+  std::shared_ptr<VarMgr> var_mgr_;
+  int tier_count_;
+  CUDD::ADD tiers_;
+  std::unordered_map<int, CUDD::BDD> adversarial_output_function_;
+  std::unordered_map<int, CUDD::BDD> cooperative_output_function_;
+
+  static std::unordered_map<int, CUDD::BDD> merge_output_functions(
+      const std::vector<SynthesisResult>& results,
+      const std::vector<CUDD::BDD>& regions);
+
+ public:
+
+  /**
+   * \brief Folds the results of the games of all tiers.
+   *
+   * \param var_mgr The variable manager of the arenas.
+   * \param adversarial_results The results of the adversarial games, from
+   *   the most to the least determined tier.
+   * \param cooperative_results The results of the cooperative games, in the
+   *   same order.
+   */
+  TierMap(std::shared_ptr<VarMgr> var_mgr,
+          const std::vector<SynthesisResult>& adversarial_results,
+          const std::vector<SynthesisResult>& cooperative_results);
+
+  /**
+   * \brief Returns the tiers that determine the move in \a state.
+   *
+   * \param state An assignment to all variables, as for CUDD::BDD::Eval.
+   * \param least_valid_tier Tiers below it are no longer considered for the
+   *   adversarial strategy, as their environment has been violated.
+   */
+  TierSelection select(const std::vector<int>& state,
+                       int least_valid_tier) const;
+
+  /**
+   * \brief Returns the output function of the strategy for \a selection.
+   *
+   * This is the merged adversarial output function if \a selection has an
+   * adversarial tier and the merged cooperative one otherwise; the latter is
+   * meaningless if \a selection has no cooperative tier either.
+   */
+  const std::unordered_map<int, CUDD::BDD>& output_function(
+      const TierSelection& selection) const;
+};
+
+}
+
+#endif // TIER_MAP_H
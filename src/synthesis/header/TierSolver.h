@@ -0,0 +1,126 @@
+#ifndef TIER_SOLVER_H
+#define TIER_SOLVER_H
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Synthesizer.h"
+#include "VarMgr.h"
+
+namespace Syft {
+
+/**
+ * \brief Which games of a chain of tiers are solved.
+ *
+ * All solves the adversarial, negated-environment and cooperative games of
+ * every tier. SkipRealizable does not solve the negated-environment and
+ * cooperative games of the tiers whose adversarial game is won from the
+ * initial state, since their realizability is reported through the
+ * adversarial game. The adversarial goal can be reached by violating the
+ * environment, so the adversarial strategy is not used in their place.
+ *
+ * Frontier additionally relies on the tiers being monotone: a goal
+ * realizable under a tier is realizable under all more determined tiers, and
+ * a goal cooperatively realizable under a tier is cooperatively realizable
+ * under all less determined tiers. The tiers where realizability changes are
+ * then found by binary search, and the games of the other tiers are not
+ * solved.
+ */
+enum class TierSolving {
+  All,
+  SkipRealizable,
+  Frontier
+};
+
+std::string to_string(TierSolving solving);
+
+/**
+ * \brief Returns the mode named \a name, i.e., "all", "skip" or "frontier".
+ */
+TierSolving tier_solving_from_string(const std::string& name);
+
+/**
+ * \brief Solves the games of a chain of tiers, ordered from the most to the
+ * least determined one.
+ *
+ * The realizability of a game that is not solved is inferred from a
+ * neighbouring tier: for the adversarial games the nearest solved less
+ * determined tier, for the cooperative ones the nearest solved more
+ * determined tier. If all tiers share their arena, a realizable tier also
+ * takes a copy of the strategy and winning region of that tier, which still
+ * wins under it and under-approximates its winning region. Otherwise, and
+ * for the unrealizable tiers and the cooperative games of the tiers that are
+ * adversarially realizable, the result has an empty winning region and no
+ * transducer, so that interactive mode does not play it.
+ */
+class TierSolver {
+ public:
+
+  /**
+   * \brief Solves the game of the tier with the given index.
+   */
+  using Game = std::function<SynthesisResult(int)>;
+
+ private:
+
+  std::shared_ptr<VarMgr> var_mgr_;
+  int tier_count_;
+  TierSolving solving_;
+  Game adversarial_game_;
+  Game cooperative_game_;
+
+  SynthesisResult solve(const char* name, const Game& game, int tier,
+                        std::vector<std::optional<double>>& times) const;
+
+  bool shared_arena_;
+
+  SynthesisResult without_strategy(bool realizability) const;
+
+  SynthesisResult inferred_from(const SynthesisResult& result) const;
+
+ public:
+
+  /**
+   * \brief Creates a solver for \a tier_count tiers.
+   *
+   * \param adversarial_game Solves the adversarial game of a tier.
+   * \param cooperative_game Solves the negated-environment game of a tier,
+   *   restricts the arena to its winning region and solves the cooperative
+   *   game on it.
+   * \param shared_arena Whether the adversarial games of all tiers are on the
+   *   same arena, and the restricted arenas of the cooperative games on the
+   *   same state variables, so that strategies can be copied between tiers.
+   */
+  TierSolver(std::shared_ptr<VarMgr> var_mgr,
+             int tier_count,
+             TierSolving solving,
+             Game adversarial_game,
+             Game cooperative_game,
+             bool shared_arena = false);
+
+  /**
+   * \brief Returns the results of the adversarial games of all tiers.
+   *
+   * \param times Set to the time in seconds spent on the game of each tier,
+   *   or to nothing if the game was not solved.
+   */
+  std::vector<SynthesisResult> solve_adversarial_games(
+      std::vector<std::optional<double>>& times) const;
+
+  /**
+   * \brief Returns the results of the cooperative games of all tiers, given
+   * the results of the adversarial ones.
+   *
+   * \param times As for solve_adversarial_games.
+   */
+  std::vector<SynthesisResult> solve_cooperative_games(
+      const std::vector<SynthesisResult>& adversarial_results,
+      std::vector<std::optional<double>>& times) const;
+};
+
+}
+
+#endif // TIER_SOLVER_H
@@ -21,6 +21,8 @@ class Transducer {
 
   friend class BestEffortSynthesizer;
   friend class CompositionalBeSynthesizer;
+  friend class StrategySimulator;
+  friend class BisimulationQuotient;
 
  private:
 
@@ -29,6 +31,7 @@ class Transducer {
   std::vector<int> initial_vector_;
   std::unordered_map<int, CUDD::BDD> output_function_;
   std::vector<CUDD::BDD> transition_function_;
+  std::size_t automaton_id_;
   Player starting_player_;
   Player protagonist_player_;
 
@@ -38,6 +41,7 @@ class Transducer {
              std::vector<int> initial_vector,
              std::unordered_map<int, CUDD::BDD> output_function,
              std::vector<CUDD::BDD> transition_function,
+             std::size_t automaton_id,
              Player starting_player,
              Player protagonist_player = Player::Agent);
 
@@ -49,7 +53,7 @@ class Transducer {
   /**
    * @brief Get the output function of a Transducer
    */
-  std::unordered_map<int, CUDD::BDD> get_output_function() const;
+  const std::unordered_map<int, CUDD::BDD>& get_output_function() const;
 
 };
 
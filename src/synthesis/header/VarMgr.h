@@ -7,10 +7,35 @@
 
 #include "cuddObj.hh"
 
+#include "BddBackend.h"
+#include "Deadline.h"
+
 class Domain;
 
 namespace Syft {
 
+/**
+ * \brief The role of a BDD variable.
+ */
+enum class VariableRole {
+  Named,   // named, but not yet partitioned between inputs and outputs
+  Input,   // X
+  Output,  // Y
+  State    // Z
+};
+
+/**
+ * \brief What VarMgr knows about the BDD variable with a given index.
+ */
+struct VariableInfo {
+  VariableRole role = VariableRole::Named;
+  std::size_t automaton_id = 0;  // state variables: automaton that created it
+  std::size_t bit = 0;           // position in the state vector of the
+                                 // automaton, or among inputs or outputs
+  int name_id = -1;              // named variables: position in creation
+                                 // order; -1 for state variables
+};
+
 /**
  * \brief A dictionary that maps variable names to indices and vice versa.
  */
@@ -28,8 +53,15 @@ class VarMgr {
   std::vector<std::vector<CUDD::BDD>> state_variables_; // Z variables
   std::vector<CUDD::BDD> input_variables_;              // X variables
   std::vector<CUDD::BDD> output_variables_;             // Y variables
+  std::shared_ptr<Deadline> deadline_;
+  BddBackendKind bdd_backend_ = BddBackendKind::Cudd;
+  std::vector<VariableInfo> variable_info_;             // by CUDD index
+  std::size_t named_variable_count_ = 0;
+  std::vector<CUDD::BDD> scratch_variables_;            // see scratch_variables
   // std::size_t total_variable_count_;    // number of Z, X and Y variables
 
+  void set_variable_info(int index, const VariableInfo& info);
+
   public:
 
   /**
@@ -41,13 +73,25 @@ class VarMgr {
    * @brief Returns mapping of int IDs to variable names
    * 
    */
-  std::unordered_map<int, std::string> get_index_to_name() const;
+  const std::unordered_map<int, std::string>& get_index_to_name() const;
 
   /**
    * @brief Returns mapping of variable names to BDDs
    * 
    */
-  std::unordered_map<std::string, CUDD::BDD> get_name_to_variable() const;
+  const std::unordered_map<std::string, CUDD::BDD>& get_name_to_variable() const;
+
+  /**
+   * \brief Returns the role, automaton, bit and name of variable \a index.
+   *
+   * Takes constant time; \a index is the CUDD index of the variable.
+   */
+  const VariableInfo& variable_info(int index) const;
+
+  /**
+   * \brief Returns the number of named (X and Y) variables.
+   */
+  std::size_t named_variable_count() const;
 
   /**
    * @brief Determine whether a string is an input variable
@@ -93,6 +137,19 @@ class VarMgr {
    */
   std::size_t create_state_variables(std::size_t variable_count);
 
+  /**
+   * \brief Returns state variables to be used as scratch space within a
+   * computation, e.g., as the next state of a transition relation.
+   *
+   * The variables are shared by all the callers: they are only created when
+   * more are requested than ever before, and reused otherwise, so that
+   * repeated computations do not keep growing the manager. No BDD that
+   * outlives the computation may depend on them.
+   *
+   * \param variable_count The number of variables needed.
+   */
+  std::vector<CUDD::BDD> scratch_variables(std::size_t variable_count);
+
 
 
   /**
@@ -100,7 +157,8 @@ class VarMgr {
    *
    * This function does not create new state variables. Instead, the variables
    * associated with the new ID are the union of all variables for the automata
-   * that form the product.
+   * that form the product, in order, each variable only the first time it
+   * occurs, e.g., when two of the automata are products sharing a factor.
    *
    * \param automaton_ids A vector of automaton IDs all of which must already
    *   exist in the manager.
@@ -137,6 +195,9 @@ class VarMgr {
    *   inputs.
    * \param output_names The names of the variables that should be considered
    *   outputs.
+   *
+   * Only one partition is allowed, but the same partition may be given again,
+   * e.g., by synthesizers that share the manager.
    */
   void partition_variables(const std::vector<std::string>& input_names,
 			   const std::vector<std::string>& output_names);
@@ -146,6 +207,40 @@ class VarMgr {
    */
   std::shared_ptr<CUDD::Cudd> cudd_mgr() const;
   
+  /**
+   * \brief Bounds the computations that use this manager by a deadline.
+   *
+   * The deadline is also registered as the termination callback of the CUDD
+   * manager, so that long BDD operations are aborted with a DeadlineExceeded
+   * exception once it expires.
+   *
+   * \param deadline The deadline, or nullptr to remove the current one.
+   */
+  void set_deadline(std::shared_ptr<Deadline> deadline);
+
+  /**
+   * \brief Returns the deadline of the manager, or nullptr if there is none.
+   */
+  std::shared_ptr<Deadline> deadline() const;
+
+  /**
+   * \brief Throws DeadlineExceeded if the deadline of the manager has expired.
+   */
+  void check_deadline() const;
+
+  /**
+   * \brief Selects the BDD package that solves the fixpoints of the games
+   * played on the variables of this manager (CUDD by default).
+   *
+   * Throws an exception if the package was not compiled in.
+   */
+  void set_bdd_backend(BddBackendKind backend);
+
+  /**
+   * \brief Returns the BDD package that solves the fixpoints of the games.
+   */
+  BddBackendKind bdd_backend() const;
+
   /**
    * \brief Returns the index of the variable with the given name.
    */
@@ -154,7 +249,7 @@ class VarMgr {
   /**
    * \brief Returns the name of the variable at index \a index.
    */
-  std::string index_to_name(int index) const;
+  const std::string& index_to_name(int index) const;
   
   /**
    * \brief Returns the total number of variables, including named and state.
@@ -0,0 +1,113 @@
+#include "BatchEvaluator.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace Syft {
+
+namespace {
+
+class NodeCollector {
+ private:
+
+  std::unordered_map<DdNode*, std::uint32_t> positions_;   // regular nodes
+
+ public:
+
+  std::vector<unsigned int> variables;
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> children;
+
+  NodeCollector() {
+    // position 0 is the constant one
+    variables.push_back(0);
+    children.emplace_back(0, 0);
+  }
+
+  std::uint32_t reference(DdNode* node) {
+    DdNode* regular = Cudd_Regular(node);
+    std::uint32_t complemented = Cudd_IsComplement(node) ? 1 : 0;
+
+    if (Cudd_IsConstant(regular)) {
+      return complemented;
+    }
+
+    auto it = positions_.find(regular);
+    if (it != positions_.end()) {
+      return (it->second << 1) | complemented;
+    }
+
+    std::uint32_t then_child = reference(Cudd_T(regular));
+    std::uint32_t else_child = reference(Cudd_E(regular));
+
+    std::uint32_t position = variables.size();
+    variables.push_back(Cudd_NodeReadIndex(regular));
+    children.emplace_back(then_child, else_child);
+    positions_.emplace(regular, position);
+
+    return (position << 1) | complemented;
+  }
+};
+
+}
+
+BatchEvaluator::BatchEvaluator(const std::vector<CUDD::BDD>& functions) {
+  NodeCollector collector;
+
+  for (const CUDD::BDD& function : functions) {
+    roots_.push_back(collector.reference(function.getNode()));
+  }
+
+  nodes_.reserve(collector.variables.size());
+  for (std::size_t i = 0; i < collector.variables.size(); ++i) {
+    nodes_.push_back({collector.variables[i], collector.children[i].first,
+                      collector.children[i].second});
+
+    if (i > 0) {
+      variable_count_ = std::max<std::size_t>(variable_count_,
+                                              collector.variables[i] + 1);
+    }
+  }
+}
+
+std::size_t BatchEvaluator::function_count() const {
+  return roots_.size();
+}
+
+std::size_t BatchEvaluator::variable_count() const {
+  return variable_count_;
+}
+
+void BatchEvaluator::evaluate(const std::uint64_t* assignments,
+                              std::size_t words,
+                              std::uint64_t* results) const {
+  values_.resize(nodes_.size() * words);
+  std::uint64_t* values = values_.data();
+
+  std::fill(values, values + words, ~std::uint64_t(0));
+
+  for (std::size_t n = 1; n < nodes_.size(); ++n) {
+    const Node& node = nodes_[n];
+    const std::uint64_t* variable = assignments + node.variable * words;
+    const std::uint64_t* then_values = values + (node.then_child >> 1) * words;
+    const std::uint64_t* else_values = values + (node.else_child >> 1) * words;
+    std::uint64_t then_mask = -std::uint64_t(node.then_child & 1);
+    std::uint64_t else_mask = -std::uint64_t(node.else_child & 1);
+    std::uint64_t* node_values = values + n * words;
+
+    for (std::size_t w = 0; w < words; ++w) {
+      node_values[w] = (variable[w] & (then_values[w] ^ then_mask)) |
+                       (~variable[w] & (else_values[w] ^ else_mask));
+    }
+  }
+
+  for (std::size_t f = 0; f < roots_.size(); ++f) {
+    const std::uint64_t* root_values = values + (roots_[f] >> 1) * words;
+    std::uint64_t mask = -std::uint64_t(roots_[f] & 1);
+
+    for (std::size_t w = 0; w < words; ++w) {
+      results[f * words + w] = root_values[w] ^ mask;
+    }
+  }
+}
+
+}
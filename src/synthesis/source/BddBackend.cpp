@@ -0,0 +1,444 @@
+#include "BddBackend.h"
+
+#include <stdexcept>
+
+#include "Profiler.h"
+#include "VarMgr.h"
+
+#ifdef SYFT_WITH_SYLVAN
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include <sylvan.h>
+#include <sylvan_obj.hpp>
+#endif
+
+namespace Syft {
+
+namespace {
+
+/**
+ * A backend provides the BDD type of its package, conversions from and to
+ * CUDD, and the operations of the fixpoint: conjunction, disjunction, negation
+ * and equality as operators of the BDD type, composition with the transition
+ * function, quantification, conjunction followed by existential quantification
+ * in a single pass, and evaluation.
+ */
+class CuddBackend {
+ public:
+
+  using Bdd = CUDD::BDD;
+  using ComposeMap = std::vector<CUDD::BDD>;
+  using Cube = CUDD::BDD;
+
+  Bdd import_bdd(const CUDD::BDD& bdd) {
+    return bdd;
+  }
+
+  CUDD::BDD export_bdd(const Bdd& bdd) {
+    return bdd;
+  }
+
+  ComposeMap import_compose_map(const std::vector<CUDD::BDD>& vector) {
+    return vector;
+  }
+
+  Cube import_cube(const CUDD::BDD& cube) {
+    return cube;
+  }
+
+  Bdd vector_compose(const Bdd& bdd, const ComposeMap& map) const {
+    return bdd.VectorCompose(map);
+  }
+
+  Bdd exists(const Bdd& bdd, const Cube& cube) const {
+    return bdd.ExistAbstract(cube);
+  }
+
+  Bdd forall(const Bdd& bdd, const Cube& cube) const {
+    return bdd.UnivAbstract(cube);
+  }
+
+  Bdd and_exists(const Bdd& bdd, const Bdd& other, const Cube& cube) const {
+    return bdd.AndAbstract(other, cube);
+  }
+
+  bool eval(const Bdd& bdd, const std::vector<int>& assignment) const {
+    // CUDD::BDD::Eval does not take the assignment as const
+    std::vector<int> copy(assignment);
+    return bdd.Eval(copy.data()).IsOne();
+  }
+};
+
+#ifdef SYFT_WITH_SYLVAN
+
+void start_sylvan() {
+  static std::once_flag started;
+
+  std::call_once(started, [] {
+    // one worker per core, and at most 4 GB of nodes and operation cache
+    lace_start(0, 0);
+    sylvan_set_limits(4LL << 30, 1, 5);
+    sylvan_init_package();
+    sylvan_init_bdd();
+  });
+}
+
+class SylvanBackend {
+ private:
+
+  std::shared_ptr<CUDD::Cudd> mgr_;
+  std::unordered_map<DdNode*, sylvan::Bdd> imported_;   // regular CUDD nodes
+  std::unordered_map<BDD, CUDD::BDD> exported_;
+
+  sylvan::Bdd import_node(DdNode* node) {
+    DdNode* regular = Cudd_Regular(node);
+    sylvan::Bdd result;
+
+    if (Cudd_IsConstant(regular)) {
+      result = sylvan::Bdd::bddOne();
+    } else {
+      auto it = imported_.find(regular);
+
+      if (it != imported_.end()) {
+        result = it->second;
+      } else {
+        sylvan::Bdd then_bdd = import_node(Cudd_T(regular));
+        sylvan::Bdd else_bdd = import_node(Cudd_E(regular));
+        result = sylvan::Bdd::bddVar(Cudd_NodeReadIndex(regular))
+          .Ite(then_bdd, else_bdd);
+        imported_.emplace(regular, result);
+      }
+    }
+
+    return Cudd_IsComplement(node) ? !result : result;
+  }
+
+ public:
+
+  using Bdd = sylvan::Bdd;
+  using ComposeMap = sylvan::BddMap;
+  using Cube = sylvan::BddSet;
+
+  explicit SylvanBackend(std::shared_ptr<CUDD::Cudd> mgr)
+    : mgr_(std::move(mgr)) {
+    start_sylvan();
+  }
+
+  Bdd import_bdd(const CUDD::BDD& bdd) {
+    return import_node(bdd.getNode());
+  }
+
+  // variables are created through ITE, so that the result does not depend on
+  // the variable order of either package
+  CUDD::BDD export_bdd(const Bdd& bdd) {
+    if (bdd.isOne()) {
+      return mgr_->bddOne();
+    } else if (bdd.isZero()) {
+      return mgr_->bddZero();
+    }
+
+    auto it = exported_.find(bdd.GetBDD());
+    if (it != exported_.end()) {
+      return it->second;
+    }
+
+    CUDD::BDD then_bdd = export_bdd(bdd.Then());
+    CUDD::BDD else_bdd = export_bdd(bdd.Else());
+    CUDD::BDD result = mgr_->bddVar(bdd.TopVar()).Ite(then_bdd, else_bdd);
+    exported_.emplace(bdd.GetBDD(), result);
+
+    return result;
+  }
+
+  ComposeMap import_compose_map(const std::vector<CUDD::BDD>& vector) {
+    ComposeMap map;
+
+    // only the state variables are replaced, the others map to themselves
+    for (std::size_t i = 0; i < vector.size(); ++i) {
+      if (vector[i] != mgr_->bddVar(i)) {
+        map.put(i, import_bdd(vector[i]));
+      }
+    }
+
+    return map;
+  }
+
+  Cube import_cube(const CUDD::BDD& cube) {
+    return Cube(import_bdd(cube));
+  }
+
+  Bdd vector_compose(const Bdd& bdd, const ComposeMap& map) const {
+    return bdd.Compose(map);
+  }
+
+  Bdd exists(const Bdd& bdd, const Cube& cube) const {
+    return bdd.ExistAbstract(cube);
+  }
+
+  Bdd forall(const Bdd& bdd, const Cube& cube) const {
+    return bdd.UnivAbstract(cube);
+  }
+
+  Bdd and_exists(const Bdd& bdd, const Bdd& other, const Cube& cube) const {
+    return bdd.AndAbstract(other, cube);
+  }
+
+  bool eval(Bdd bdd, const std::vector<int>& assignment) const {
+    while (!bdd.isTerminal()) {
+      bdd = assignment[bdd.TopVar()] ? bdd.Then() : bdd.Else();
+    }
+
+    return bdd.isOne();
+  }
+};
+
+#endif
+
+template <class Backend>
+struct BackendQuantifier {
+  bool universal;
+  typename Backend::Cube variables;
+};
+
+template <class Backend>
+std::vector<BackendQuantifier<Backend>> import_quantifiers(
+    Backend& backend, const std::vector<Quantifier>& quantifiers) {
+  std::vector<BackendQuantifier<Backend>> imported;
+
+  for (const Quantifier& quantifier : quantifiers) {
+    imported.push_back({quantifier.universal,
+                        backend.import_cube(quantifier.variables)});
+  }
+
+  return imported;
+}
+
+template <class Backend>
+typename Backend::Bdd quantify(
+    const Backend& backend,
+    const std::vector<BackendQuantifier<Backend>>& quantifiers,
+    typename Backend::Bdd bdd) {
+  for (const BackendQuantifier<Backend>& quantifier : quantifiers) {
+    bdd = quantifier.universal ? backend.forall(bdd, quantifier.variables) :
+                                 backend.exists(bdd, quantifier.variables);
+  }
+
+  return bdd;
+}
+
+template <class Backend>
+ReachabilityFixpoint reachability_fixpoint(const VarMgr& var_mgr,
+                                           Backend& backend,
+                                           const ReachabilityArena& arena) {
+  using Bdd = typename Backend::Bdd;
+
+  typename Backend::ComposeMap transition_map =
+    backend.import_compose_map(arena.transition_vector);
+  auto preimage_quantifiers =
+    import_quantifiers(backend, arena.preimage_quantifiers);
+  auto projection_quantifiers =
+    import_quantifiers(backend, arena.projection_quantifiers);
+
+  Bdd state_space = backend.import_bdd(arena.state_space);
+  Bdd winning_states = state_space & backend.import_bdd(arena.goal_states);
+  Bdd winning_moves = winning_states;
+  bool includes_initial_state = false;
+
+  for (long iteration = 0; ; ++iteration) {
+    ProfileSpan iteration_span("fixpoint iteration", "games", "iteration",
+                               iteration);
+    var_mgr.check_deadline();
+
+    // Moves from states that are not yet winning into winning states
+    Bdd preimage = quantify(backend, preimage_quantifiers,
+                            backend.vector_compose(winning_states,
+                                                   transition_map));
+    Bdd new_winning_moves = winning_moves |
+                            (state_space & (!winning_states) & preimage);
+
+    Bdd new_winning_states =
+      quantify(backend, projection_quantifiers, new_winning_moves);
+
+    bool converged = new_winning_states == winning_states;
+    winning_moves = new_winning_moves;
+    winning_states = new_winning_states;
+
+    if (backend.eval(winning_states, arena.initial_vector)) {
+      includes_initial_state = true;
+      break;
+    } else if (converged) {
+      break;
+    }
+  }
+
+  ReachabilityFixpoint fixpoint;
+  fixpoint.winning_moves = backend.export_bdd(winning_moves);
+  fixpoint.winning_states = backend.export_bdd(winning_states);
+  fixpoint.includes_initial_state = includes_initial_state;
+
+  return fixpoint;
+}
+
+// In a game where all the variables are quantified existentially, a state
+// that is not winning at some iteration has no move into the states won before
+// it, or it would have been won. The preimage is then only needed for the
+// states won at the last iteration, and its conjunction with the states that
+// are not winning yet and its projections are relational products.
+template <class Backend>
+ReachabilityFixpoint cooperative_reachability_fixpoint(
+    const VarMgr& var_mgr,
+    Backend& backend,
+    const ReachabilityArena& arena,
+    const CUDD::BDD& preimage_cube,
+    const CUDD::BDD& non_state_cube) {
+  using Bdd = typename Backend::Bdd;
+
+  typename Backend::ComposeMap transition_map =
+    backend.import_compose_map(arena.transition_vector);
+  typename Backend::Cube preimage_variables =
+    backend.import_cube(preimage_cube);
+  typename Backend::Cube non_state_variables =
+    backend.import_cube(non_state_cube);
+
+  Bdd state_space = backend.import_bdd(arena.state_space);
+  Bdd winning_states = state_space & backend.import_bdd(arena.goal_states);
+  Bdd winning_moves = winning_states;
+  Bdd frontier = winning_states;
+  Bdd zero = backend.import_bdd(var_mgr.cudd_mgr()->bddZero());
+  // as in reachability_fixpoint, the initial state is only checked after an
+  // iteration, so that the result is the same even if it is a goal state
+  bool includes_initial_state = false;
+
+  for (long iteration = 0; !includes_initial_state && frontier != zero;
+       ++iteration) {
+    ProfileSpan iteration_span("fixpoint iteration", "games", "iteration",
+                               iteration);
+    var_mgr.check_deadline();
+
+    // Moves from states that are not yet winning into the last won states
+    Bdd care_states = state_space & !winning_states;
+    Bdd successors = backend.vector_compose(frontier, transition_map);
+
+    winning_moves = winning_moves |
+                    backend.and_exists(care_states, successors,
+                                       preimage_variables);
+    frontier = backend.and_exists(care_states, successors,
+                                  non_state_variables);
+    winning_states = winning_states | frontier;
+
+    includes_initial_state = backend.eval(winning_states, arena.initial_vector);
+  }
+
+  ReachabilityFixpoint fixpoint;
+  fixpoint.winning_moves = backend.export_bdd(winning_moves);
+  fixpoint.winning_states = backend.export_bdd(winning_states);
+  fixpoint.includes_initial_state = includes_initial_state;
+
+  return fixpoint;
+}
+
+}
+
+std::string to_string(BddBackendKind backend) {
+  switch (backend) {
+    case BddBackendKind::Cudd:
+      return "cudd";
+    case BddBackendKind::Sylvan:
+      return "sylvan";
+  }
+
+  return "";
+}
+
+BddBackendKind bdd_backend_from_string(const std::string& name) {
+  if (name == "cudd") {
+    return BddBackendKind::Cudd;
+  } else if (name == "sylvan") {
+    return BddBackendKind::Sylvan;
+  }
+
+  throw std::runtime_error("Error: Unknown BDD backend " + name + ".");
+}
+
+bool bdd_backend_available(BddBackendKind backend) {
+  switch (backend) {
+    case BddBackendKind::Cudd:
+      return true;
+    case BddBackendKind::Sylvan:
+#ifdef SYFT_WITH_SYLVAN
+      return true;
+#else
+      return false;
+#endif
+  }
+
+  return false;
+}
+
+ReachabilityFixpoint solve_reachability(const VarMgr& var_mgr,
+                                        const ReachabilityArena& arena) {
+  switch (var_mgr.bdd_backend()) {
+    case BddBackendKind::Sylvan: {
+#ifdef SYFT_WITH_SYLVAN
+      SylvanBackend backend(var_mgr.cudd_mgr());
+      return reachability_fixpoint(var_mgr, backend, arena);
+#else
+      throw std::runtime_error(
+          "Error: MtSyft was built without Sylvan (SYFT_WITH_SYLVAN).");
+#endif
+    }
+    case BddBackendKind::Cudd:
+    default: {
+      CuddBackend backend;
+      return reachability_fixpoint(var_mgr, backend, arena);
+    }
+  }
+}
+
+ReachabilityFixpoint solve_cooperative_reachability(
+    const VarMgr& var_mgr, const ReachabilityArena& arena) {
+  CUDD::BDD preimage_cube = var_mgr.cudd_mgr()->bddOne();
+  CUDD::BDD non_state_cube = var_mgr.cudd_mgr()->bddOne();
+
+  for (const Quantifier& quantifier : arena.preimage_quantifiers) {
+    if (quantifier.universal) {
+      throw std::runtime_error(
+          "Error: The cooperative fixpoint needs existential quantifiers.");
+    }
+
+    preimage_cube &= quantifier.variables;
+    non_state_cube &= quantifier.variables;
+  }
+
+  for (const Quantifier& quantifier : arena.projection_quantifiers) {
+    if (quantifier.universal) {
+      throw std::runtime_error(
+          "Error: The cooperative fixpoint needs existential quantifiers.");
+    }
+
+    non_state_cube &= quantifier.variables;
+  }
+
+  switch (var_mgr.bdd_backend()) {
+    case BddBackendKind::Sylvan: {
+#ifdef SYFT_WITH_SYLVAN
+      SylvanBackend backend(var_mgr.cudd_mgr());
+      return cooperative_reachability_fixpoint(var_mgr, backend, arena,
+                                               preimage_cube, non_state_cube);
+#else
+      throw std::runtime_error(
+          "Error: MtSyft was built without Sylvan (SYFT_WITH_SYLVAN).");
+#endif
+    }
+    case BddBackendKind::Cudd:
+    default: {
+      CuddBackend backend;
+      return cooperative_reachability_fixpoint(var_mgr, backend, arena,
+                                               preimage_cube, non_state_cube);
+    }
+  }
+}
+
+}
@@ -111,12 +111,15 @@ namespace Syft
         // Pair to store results
         std::pair<SynthesisResult, SynthesisResult> best_effort_result;
 
+        // The adversarial and the negated environment games are on the same arena
+        auto game_arena = std::make_shared<const GameArena>(arena_[0]);
+
         // Step 3. Compute winning strategy in the adversarial game
 
         auto start_adversarial_game = std::chrono::high_resolution_clock::now();
 
         std::cout << "Solving synthesis on the adversarial game..." << std::endl;
-        ReachabilitySynthesizer adversarial_synthesizer(arena_[0],
+        ReachabilitySynthesizer adversarial_synthesizer(game_arena,
                                                         starting_player_,
                                                         Player::Agent,
                                                         (!(symbolic_dfas_[1].final_states() * (!symbolic_dfas_[0].final_states()))) * !arena_[0].initial_state_bdd(), // Lifting
@@ -140,7 +143,7 @@ namespace Syft
         auto start_restriction = std::chrono::high_resolution_clock::now();
 
         std::cout << "Solving synthesis on the environment assumption only dfa..." << std::endl;
-        ReachabilitySynthesizer negated_environment_synthesizer(arena_[0],
+        ReachabilitySynthesizer negated_environment_synthesizer(game_arena,
                                                                 starting_player_,
                                                                 Player::Agent,  // get env winning region from agent's
                                                                 ((!symbolic_dfas_[1].final_states())) * !arena_[0].initial_state_bdd(), // Lifting
@@ -163,7 +166,7 @@ namespace Syft
         auto start_cooperative_game = std::chrono::high_resolution_clock::now();
 
         std::cout << "Solving cooperative synthesis on the reduced arena..." << std::endl;
-        CoOperativeReachabilitySynthesizer co_operative_synthesizer(arena_[0],
+        CoOperativeReachabilitySynthesizer co_operative_synthesizer(arena_[0], // pruned above
                                                                     starting_player_,
                                                                     Player::Agent,
                                                                     (symbolic_dfas_[0].final_states() * symbolic_dfas_[1].final_states()), // Lifting
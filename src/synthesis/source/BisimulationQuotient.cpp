@@ -0,0 +1,322 @@
+#include "BisimulationQuotient.h"
+
+#include <utility>
+
+#include "Profiler.h"
+
+namespace Syft {
+
+namespace {
+
+std::vector<CUDD::BDD> state_variables(const VarMgr& var_mgr,
+                                       std::size_t automaton_id) {
+  std::vector<CUDD::BDD> variables;
+
+  for (std::size_t i = 0; i < var_mgr.state_variable_count(automaton_id);
+       ++i) {
+    variables.push_back(var_mgr.state_variable(automaton_id, i));
+  }
+
+  return variables;
+}
+
+CUDD::BDD letter_cube(const VarMgr& var_mgr) {
+  CUDD::BDD cube = var_mgr.cudd_mgr()->bddOne();
+
+  for (const auto& [name, variable] : var_mgr.get_name_to_variable()) {
+    cube &= variable;
+  }
+
+  return cube;
+}
+
+// The BDD of the code of block \a block over \a variables
+CUDD::BDD block_code(const VarMgr& var_mgr, std::size_t block,
+                     const std::vector<CUDD::BDD>& variables) {
+  CUDD::BDD code = var_mgr.cudd_mgr()->bddOne();
+
+  for (std::size_t i = 0; i < variables.size(); ++i) {
+    code &= ((block >> i) & 1) ? variables[i] : !variables[i];
+  }
+
+  return code;
+}
+
+CUDD::BDD reachable_states(const VarMgr& var_mgr,
+                           const SymbolicStateDfa& dfa,
+                           const std::vector<CUDD::BDD>& current,
+                           const std::vector<CUDD::BDD>& next,
+                           const CUDD::BDD& current_cube,
+                           const CUDD::BDD& letter_cube) {
+  CUDD::BDD transition_relation = var_mgr.cudd_mgr()->bddOne();
+
+  for (std::size_t i = 0; i < next.size(); ++i) {
+    transition_relation &= next[i].Xnor(dfa.transition_function()[i]);
+  }
+
+  CUDD::BDD abstracted = current_cube & letter_cube;
+  CUDD::BDD reachable = var_mgr.state_vector_to_bdd(dfa.automaton_id(),
+                                                    dfa.initial_state());
+  CUDD::BDD frontier = reachable;
+
+  while (!frontier.IsZero()) {
+    var_mgr.check_deadline();
+
+    CUDD::BDD image = transition_relation.AndAbstract(frontier, abstracted)
+      .SwapVariables(next, current);
+    frontier = image & !reachable;
+    reachable |= frontier;
+  }
+
+  return reachable;
+}
+
+}
+
+BisimulationQuotient::BisimulationQuotient(const SymbolicStateDfa& original,
+                                           const SymbolicStateDfa& quotient,
+                                           bool identity)
+  : original_(original), quotient_(quotient), identity_(identity) {}
+
+BisimulationQuotient BisimulationQuotient::minimize(
+    const SymbolicStateDfa& dfa,
+    const std::vector<CUDD::BDD>& labels) {
+  ProfileSpan span("bisimulation minimization", "dfa2symbolic");
+
+  std::shared_ptr<VarMgr> var_mgr = dfa.var_mgr();
+  std::size_t state_count = var_mgr->state_variable_count(dfa.automaton_id());
+
+  // Scratch variables, used as the next state to compute the reachable states
+  // and then to number the blocks of the partition, and reused by the next
+  // minimizations
+  std::vector<CUDD::BDD> current = state_variables(*var_mgr,
+                                                   dfa.automaton_id());
+  std::vector<CUDD::BDD> next = var_mgr->scratch_variables(state_count);
+  CUDD::BDD current_cube = var_mgr->cudd_mgr()->computeCube(current);
+  CUDD::BDD block_cube = var_mgr->cudd_mgr()->computeCube(next);
+  CUDD::BDD letters = letter_cube(*var_mgr);
+
+  CUDD::BDD reachable = reachable_states(*var_mgr, dfa, current, next,
+                                         current_cube, letters);
+
+  // Initial partition: the reachable states split by the labels
+  CUDD::BDD initial_state = var_mgr->state_vector_to_bdd(dfa.automaton_id(),
+                                                         dfa.initial_state());
+  std::vector<CUDD::BDD> all_labels = labels;
+  all_labels.push_back(dfa.final_states());
+  all_labels.push_back(initial_state);
+
+  std::vector<CUDD::BDD> blocks = {reachable};
+
+  for (const CUDD::BDD& label : all_labels) {
+    std::vector<CUDD::BDD> split;
+
+    for (const CUDD::BDD& block : blocks) {
+      for (CUDD::BDD part : {block & label, block & !label}) {
+        if (!part.IsZero()) {
+          split.push_back(std::move(part));
+        }
+      }
+    }
+
+    blocks = std::move(split);
+  }
+
+  std::vector<CUDD::BDD> transition_vector = var_mgr->make_compose_vector(
+      dfa.automaton_id(), dfa.transition_function());
+  CUDD::BDD signature_cube = letters & block_cube;
+
+  while (true) {
+    var_mgr->check_deadline();
+
+    // The signature of a state relates each letter to the block of its
+    // successor
+    CUDD::BDD partition = var_mgr->cudd_mgr()->bddZero();
+    for (std::size_t j = 0; j < blocks.size(); ++j) {
+      partition |= blocks[j] & block_code(*var_mgr, j, next);
+    }
+    CUDD::BDD signatures = partition.VectorCompose(transition_vector);
+
+    // Splits each block into the classes of states with the same signature,
+    // taking the signature of one state of the block at a time
+    std::vector<CUDD::BDD> refined;
+
+    for (const CUDD::BDD& block : blocks) {
+      CUDD::BDD rest = block;
+
+      while (!rest.IsZero()) {
+        var_mgr->check_deadline();
+
+        CUDD::BDD state = rest.PickOneMinterm(current);
+        CUDD::BDD signature = signatures.Cofactor(state);
+        CUDD::BDD same_signature =
+          rest & signatures.Xnor(signature).UnivAbstract(signature_cube);
+
+        refined.push_back(same_signature);
+        rest &= !same_signature;
+      }
+    }
+
+    bool stable = refined.size() == blocks.size();
+    blocks = std::move(refined);
+
+    if (stable) {
+      break;
+    }
+  }
+
+  // The block of the initial state gets code 0
+  for (std::size_t j = 0; j < blocks.size(); ++j) {
+    if (!(blocks[j] & initial_state).IsZero()) {
+      std::swap(blocks[0], blocks[j]);
+      break;
+    }
+  }
+
+  // Encodes the blocks in as many variables as needed, but at least one
+  std::size_t bit_count = 1;
+  while ((std::size_t(1) << bit_count) < blocks.size()) {
+    ++bit_count;
+  }
+
+  // The quotient needs variables of its own, since it outlives the
+  // minimization, but only logarithmically many in the number of blocks
+  std::size_t quotient_id = var_mgr->create_state_variables(bit_count);
+  std::vector<CUDD::BDD> quotient_variables = state_variables(*var_mgr,
+                                                              quotient_id);
+
+  std::vector<CUDD::BDD> code(bit_count, var_mgr->cudd_mgr()->bddZero());
+  for (std::size_t j = 0; j < blocks.size(); ++j) {
+    for (std::size_t i = 0; i < bit_count; ++i) {
+      if ((j >> i) & 1) {
+        code[i] |= blocks[j];
+      }
+    }
+  }
+
+  CUDD::BDD code_relation = reachable;
+  for (std::size_t i = 0; i < bit_count; ++i) {
+    code_relation &= quotient_variables[i].Xnor(code[i]);
+  }
+
+  // All the states of a block move to the same block, so any of them gives
+  // the transitions of the quotient
+  transition_vector = var_mgr->make_compose_vector(dfa.automaton_id(),
+                                                   dfa.transition_function());
+  std::vector<CUDD::BDD> transition_function;
+  for (std::size_t i = 0; i < bit_count; ++i) {
+    transition_function.push_back(code_relation.AndAbstract(
+        code[i].VectorCompose(transition_vector), current_cube));
+  }
+
+  // Unless the number of blocks is a power of two, some codes number no block
+  CUDD::BDD valid_codes = SymbolicStateDfa::dont_care_encoding() ?
+    code_relation.ExistAbstract(current_cube) :
+    var_mgr->cudd_mgr()->bddOne();
+
+  SymbolicStateDfa quotient = SymbolicStateDfa::from_bdds(
+      var_mgr,
+      quotient_id,
+      std::vector<int>(bit_count, 0),
+      code_relation.AndAbstract(dfa.final_states(), current_cube),
+      std::move(transition_function),
+      std::move(valid_codes));
+
+  BisimulationQuotient minimized(dfa, quotient, false);
+  minimized.block_count_ = blocks.size();
+  minimized.reachable_states_ = std::move(reachable);
+  minimized.original_state_cube_ = std::move(current_cube);
+  minimized.block_code_ = std::move(code);
+  minimized.code_relation_ = std::move(code_relation);
+
+  return minimized;
+}
+
+BisimulationQuotient BisimulationQuotient::identity(
+    const SymbolicStateDfa& dfa) {
+  return BisimulationQuotient(dfa, dfa, true);
+}
+
+const SymbolicStateDfa& BisimulationQuotient::dfa() const {
+  return quotient_;
+}
+
+const SymbolicStateDfa& BisimulationQuotient::original() const {
+  return original_;
+}
+
+bool BisimulationQuotient::minimized() const {
+  return !identity_;
+}
+
+std::size_t BisimulationQuotient::block_count() const {
+  return block_count_;
+}
+
+double BisimulationQuotient::reachable_state_count() const {
+  return reachable_states_.CountMinterm(
+      original_.var_mgr()->state_variable_count(original_.automaton_id()));
+}
+
+CUDD::BDD BisimulationQuotient::to_quotient(const CUDD::BDD& states) const {
+  if (identity_) {
+    return states;
+  }
+
+  return code_relation_.AndAbstract(states, original_state_cube_);
+}
+
+CUDD::BDD BisimulationQuotient::from_quotient(const CUDD::BDD& states) const {
+  if (identity_) {
+    return states;
+  }
+
+  // built here, since variables created later make older vectors too short
+  std::vector<CUDD::BDD> code_vector =
+    original_.var_mgr()->make_compose_vector(quotient_.automaton_id(),
+                                             block_code_);
+
+  return reachable_states_ & states.VectorCompose(code_vector);
+}
+
+SynthesisResult BisimulationQuotient::from_quotient(
+    SynthesisResult result) const {
+  if (identity_) {
+    return result;
+  }
+
+  result.winning_states = from_quotient(result.winning_states);
+
+  if (result.transducer) {
+    std::unordered_map<int, CUDD::BDD> output_function;
+    for (const auto& [variable, function] :
+         result.transducer->output_function_) {
+      output_function.emplace(variable, from_quotient(function));
+    }
+
+    result.transducer = std::make_unique<Transducer>(
+        original_.var_mgr(),
+        original_.var_mgr()->make_eval_vector(original_.automaton_id(),
+                                              original_.initial_state()),
+        std::move(output_function),
+        original_.transition_function(),
+        original_.automaton_id(),
+        result.transducer->starting_player_,
+        result.transducer->protagonist_player_);
+  }
+
+  return result;
+}
+
+BisimulationQuotient BisimulationQuotient::restriction(
+    const CUDD::BDD& invalid_states) const {
+  BisimulationQuotient restricted(*this);
+  restricted.original_ = original_.get_restriction(invalid_states);
+  restricted.quotient_ = identity_ ?
+    restricted.original_ :
+    quotient_.get_restriction(to_quotient(invalid_states));
+
+  return restricted;
+}
+
+}
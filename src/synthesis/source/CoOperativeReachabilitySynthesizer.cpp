@@ -1,6 +1,8 @@
 #include "CoOperativeReachabilitySynthesizer.h"
 #include <cassert>
 
+#include "Profiler.h"
+
 namespace Syft {
 
 CoOperativeReachabilitySynthesizer::CoOperativeReachabilitySynthesizer(SymbolicStateDfa spec,
@@ -11,47 +13,31 @@ CoOperativeReachabilitySynthesizer::CoOperativeReachabilitySynthesizer(SymbolicS
     , goal_states_(goal_states), state_space_(state_space)
 {}
 
+CoOperativeReachabilitySynthesizer::CoOperativeReachabilitySynthesizer(std::shared_ptr<const GameArena> arena,
+						 Player starting_player, Player protagonist_player,
+						 CUDD::BDD goal_states,
+						 CUDD::BDD state_space)
+    : CoOperativeDfaGameSynthesizer(std::move(arena), starting_player, protagonist_player)
+    , goal_states_(goal_states), state_space_(state_space)
+{}
+
 
 SynthesisResult CoOperativeReachabilitySynthesizer::run() const {
-  SynthesisResult result;
-  CUDD::BDD winning_states = state_space_ & goal_states_;
-  CUDD::BDD winning_moves = winning_states;
-
-  while (true) {
-    CUDD::BDD new_winning_moves = winning_moves |
-                                  (state_space_ & (!winning_states) & preimage(winning_states));
-
-    CUDD::BDD new_winning_states = project_into_states(new_winning_moves);
-
-    if (includes_initial_state(new_winning_states)) {
-        result.realizability = true;
-        result.winning_states = new_winning_states;
-        std::unordered_map<int, CUDD::BDD> strategy = synthesize_strategy(
-              new_winning_moves);
-
-        result.transducer = std::make_unique<Transducer>(
-              var_mgr_, initial_vector_, strategy, spec_.transition_function(),
-              starting_player_, protagonist_player_);
-        return result;
-
-    } else if (new_winning_states == winning_states) {
-        result.realizability = false;
-        result.winning_states = new_winning_states;
-        // result.transducer = nullptr;
-        std::unordered_map<int, CUDD::BDD> strategy = synthesize_strategy(
-          new_winning_moves);
-
-        result.transducer = std::make_unique<Transducer>(
-              var_mgr_, initial_vector_, strategy, spec_.transition_function(),
-              starting_player_, protagonist_player_);
-        return result;
-    
-    }
-
-    winning_moves = new_winning_moves;
-    winning_states = new_winning_states;
-  }
+  ProfileSpan span("cooperative reachability game", "games");
 
+  ReachabilityFixpoint fixpoint = solve_cooperative_reachability(
+      *var_mgr_, reachability_arena(goal_states_, state_space_));
+
+  SynthesisResult result;
+  result.realizability = fixpoint.includes_initial_state;
+  result.winning_states = fixpoint.winning_states;
+  std::unordered_map<int, CUDD::BDD> strategy = synthesize_strategy(
+        fixpoint.winning_moves);
+
+  result.transducer = std::make_unique<Transducer>(
+        var_mgr_, arena_->initial_vector(), strategy, spec_.transition_function(),
+        spec_.automaton_id(), starting_player_, protagonist_player_);
+  return result;
 }
 
 }
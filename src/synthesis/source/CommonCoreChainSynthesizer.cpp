@@ -1,4 +1,9 @@
 #include"CommonCoreChainSynthesizer.h"
+#include"ConjunctiveDfa.h"
+#include"Profiler.h"
+
+#include<numeric>
+#include<optional>
 
 namespace Syft {
 
@@ -8,51 +13,76 @@ namespace Syft {
         std::string env_core,
         std::vector<std::string> conjuncts,
         Syft::InputOutputPartition partition,
-        Syft::Player starting_player
+        Syft::Player starting_player,
+        std::shared_ptr<EnvironmentCache> environment_cache
         ) : var_mgr_(var_mgr),
             ltlf_goal_(ltlf_goal),
             env_core_(env_core),
             conjuncts_(conjuncts),
             partition_(partition),
-            starting_player_(starting_player)     // be careful on constructor. bad_alloc might be issued if u use bad arguments
+            starting_player_(starting_player),     // be careful on constructor. bad_alloc might be issued if u use bad arguments
+            environment_cache_(environment_cache ? environment_cache : std::make_shared<EnvironmentCache>(var_mgr))
         {
+            if (environment_cache_->var_mgr() != var_mgr_) {
+                throw std::runtime_error("Error: The environment cache belongs to another variable manager.");
+            }
+
+            Syft::Stopwatch construction;
+            construction.start();
+
+            try {
+                construct_arenas();
+            } catch (const DeadlineExceeded& e) {
+                timed_out_ = true;
+                run_times_.push_back(construction.stop().count() / 1000.0 -
+                    std::accumulate(run_times_.begin(), run_times_.end(), 0.0)); // interrupted phase
+                std::cout << std::endl << "[cb-MtSyft] timeout while constructing the game arenas (" << e.what() << ")" << std::endl;
+            }
+        }
+
+        void CommonCoreChainSynthesizer::construct_arenas() {
+            // translations and symbolizations saved by the memoized DFAs
+            std::size_t memo_hits_before = ConjunctiveDfa::memo_hits();
+            std::size_t dfa_hits_before = environment_cache_->dfa_hits();
+
             Syft::Stopwatch ltlf2dfas;
             ltlf2dfas.start();
 
             Syft::Stopwatch goal2dfa;
             goal2dfa.start();
 
-            ExplicitStateDfaMona mona_goal_dfa =
-                ExplicitStateDfaMona::dfa_of_formula(ltlf_goal_);
+            ConjunctiveDfa mona_goal_dfa =
+                ConjunctiveDfa::of_formula(ltlf_goal_);
 
             double t_goal2dfa = goal2dfa.stop().count() / 1000.0;
 
+            // with a state budget, the core and each conjunct are multiplied explicitly if small enough
+            bool hybrid = HybridArenaBuilder::state_budget() > 0;
+            bool core_needed = !environment_cache_->find_dfa(env_core_);
+            for (int i = 0; i < conjuncts_.size(); ++i) {
+                if (hybrid && !environment_cache_->find_dfa(product_formula(i)) && !environment_cache_->find_dfa(conjuncts_[i])) core_needed = true;
+            }
+
             Syft::Stopwatch core2dfa;
             core2dfa.start();
 
-            ExplicitStateDfaMona mona_core_dfa =
-                ExplicitStateDfaMona::dfa_of_formula(env_core_);
+            std::optional<ConjunctiveDfa> mona_core_dfa; // empty if not needed by any arena
+            if (core_needed) mona_core_dfa = ConjunctiveDfa::of_formula(env_core_);
 
             double t_core2dfa = core2dfa.stop().count() / 1000.0;
 
             std::vector<double> conjunct2dfas;
 
-            std::vector<ExplicitStateDfaMona> mona_conjuncts_dfas;
-            for (const auto& conjunct: conjuncts_) {
+            std::vector<std::optional<ConjunctiveDfa>> mona_conjuncts_dfas; // empty if the symbolic DFA (or product) is already cached
+            for (int i = 0; i < conjuncts_.size(); ++i) {
+                var_mgr_->check_deadline();
                 Syft::Stopwatch conjunct2dfa;
                 conjunct2dfa.start();
-                mona_conjuncts_dfas.push_back(ExplicitStateDfaMona::dfa_of_formula(conjunct));
+                if (environment_cache_->reuse_dfa(product_formula(i)) || environment_cache_->reuse_dfa(conjuncts_[i])) mona_conjuncts_dfas.emplace_back();
+                else mona_conjuncts_dfas.push_back(ConjunctiveDfa::of_formula(conjuncts_[i]));
                 conjunct2dfas.push_back(conjunct2dfa.stop().count() / 1000.0);
             }
 
-            Syft::Stopwatch tau2dfa;
-            tau2dfa.start();
-
-            ExplicitStateDfaMona mona_no_empty_dfa =
-                ExplicitStateDfaMona::dfa_of_formula("F(true)");
-
-            double t_tau2dfa = tau2dfa.stop().count() / 1000.0;
-
             // debug
             // mona_goal_dfa.dfa_print();
             // std::cout << std::endl;
@@ -70,7 +100,6 @@ namespace Syft {
             for (int i = 0; i < conjunct2dfas.size(); ++i) {
                 std::cout << "\t[cb-MtSyft] env conjunct " << i+1 << " to DFA in " << conjunct2dfas[i] << " s"<< std::endl;
             }
-            std::cout << "\t[cb-MtSyft] tautology to DFA in " << t_tau2dfa << " s" << std::endl;
 
             // converting to symbolic representation
             
@@ -92,12 +121,16 @@ namespace Syft {
         
             // Rewrites the preprocessing phase to not use the SPOT parser
             // which does not interact well with Lydia (does not support Lydia's X[!])
-            var_mgr_->create_named_variables(mona_goal_dfa.names);
-            var_mgr_->create_named_variables(mona_core_dfa.names);
-            for (const auto& conjunct_dfa: mona_conjuncts_dfas) var_mgr_->create_named_variables(conjunct_dfa.names);
+            var_mgr_->create_named_variables(mona_goal_dfa.names());
+            if (mona_core_dfa) var_mgr_->create_named_variables(mona_core_dfa->names());
+            for (const auto& conjunct_dfa: mona_conjuncts_dfas) if (conjunct_dfa) var_mgr_->create_named_variables(conjunct_dfa->names());
 
             // partition
             // var_mgr_->create_named_variables(get_props(parsed_conjunct_formula));
+            // also the variables that no formula mentions, e.g., after the
+            // simplification of the formulas
+            var_mgr_->create_named_variables(partition_.input_variables);
+            var_mgr_->create_named_variables(partition_.output_variables);
             var_mgr_->partition_variables(partition_.input_variables,
                                         partition_.output_variables);
 
@@ -113,8 +146,7 @@ namespace Syft {
             Syft::Stopwatch goal2sym;
             goal2sym.start();
 
-            ExplicitStateDfa goal_dfa = ExplicitStateDfa::from_dfa_mona(var_mgr_, mona_goal_dfa);
-            SymbolicStateDfa goal_sym_dfa = SymbolicStateDfa::from_explicit(std::move(goal_dfa));
+            SymbolicStateDfa goal_sym_dfa = mona_goal_dfa.to_symbolic(*environment_cache_);
             // symbolic_dfas_.push_back(SymbolicStateDfa::from_explicit(std::move(goal_dfa)));
 
             for(int i = 0; i < mona_conjuncts_dfas.size(); ++i) {
@@ -124,35 +156,60 @@ namespace Syft {
 
             double t_goal2sym = goal2sym.stop().count() / 1000.0;
 
-            // core to symbolic
-            Syft::Stopwatch core2sym;
-            core2sym.start();
-
-            ExplicitStateDfa core_dfa = ExplicitStateDfa::from_dfa_mona(var_mgr_, mona_core_dfa);
-            SymbolicStateDfa core_sym_dfa = SymbolicStateDfa::from_explicit(std::move(core_dfa));
-            // symbolic_dfas_.push_back(SymbolicStateDfa::from_explicit(std::move(core_dfa)));
-
-            for(int i =0; i < mona_conjuncts_dfas.size(); ++i) symbolic_dfas_[i].push_back(core_sym_dfa);
+            // core to symbolic, on first use
+            double t_core2sym = 0.0;
 
-            double t_core2sym = core2sym.stop().count() / 1000.0;
+            auto core_sym_dfa = [this, &mona_core_dfa, &t_core2sym]() -> const SymbolicStateDfa& {
+                if (!environment_cache_->find_dfa(env_core_)) {
+                    Syft::Stopwatch core2sym;
+                    core2sym.start();
+                    environment_cache_->insert_dfa(env_core_, mona_core_dfa->to_symbolic(*environment_cache_));
+                    t_core2sym = core2sym.stop().count() / 1000.0;
+                }
+                return *environment_cache_->find_dfa(env_core_);
+            };
 
             std::vector<double> t_conjunct2dfas;
+            std::vector<bool> multiplied; // whether the environment of the arena is the explicit product of core and conjunct
 
-            std::vector<ExplicitStateDfa> conjunct_dfas;
             for (int i = 0; i < mona_conjuncts_dfas.size(); ++i) {
                 Syft::Stopwatch conjunct2dfa;
                 conjunct2dfa.start();
-                conjunct_dfas.push_back(ExplicitStateDfa::from_dfa_mona(var_mgr_, mona_conjuncts_dfas[i]));
-                symbolic_dfas_[i].push_back(SymbolicStateDfa::from_explicit(std::move(conjunct_dfas[i])));
-                t_conjunct2dfas.push_back(conjunct2dfa.stop().count() / 1000.0);
+                double t_core2sym_before = t_core2sym;
+
+                if (hybrid && mona_conjuncts_dfas[i]) {
+                    // the conjuncts of the core and of the conjunct are all factors of the product
+                    std::vector<ExplicitStateDfaMona> factors = mona_core_dfa->conjuncts();
+                    factors.insert(factors.end(), mona_conjuncts_dfas[i]->conjuncts().begin(), mona_conjuncts_dfas[i]->conjuncts().end());
+                    std::vector<ExplicitStateDfaMona> blocks = HybridArenaBuilder::multiply(factors, HybridArenaBuilder::state_budget());
+                    if (blocks.size() == 1) {
+                        ExplicitStateDfa product_dfa = ExplicitStateDfa::from_dfa_mona(var_mgr_, blocks[0]);
+                        environment_cache_->insert_dfa(product_formula(i), SymbolicStateDfa::from_explicit(std::move(product_dfa)));
+                    }
+                }
+
+                if (const SymbolicStateDfa* product_dfa = environment_cache_->find_dfa(product_formula(i))) {
+                    symbolic_dfas_[i].push_back(*product_dfa);
+                    environments_.push_back({product_formula(i)});
+                    multiplied.push_back(true);
+                } else {
+                    if (mona_conjuncts_dfas[i]) {
+                        environment_cache_->insert_dfa(conjuncts_[i], mona_conjuncts_dfas[i]->to_symbolic(*environment_cache_));
+                    }
+                    symbolic_dfas_[i].push_back(core_sym_dfa());
+                    symbolic_dfas_[i].push_back(*environment_cache_->find_dfa(conjuncts_[i]));
+                    environments_.push_back({env_core_, conjuncts_[i]});
+                    multiplied.push_back(false);
+                }
+
+                t_conjunct2dfas.push_back(conjunct2dfa.stop().count() / 1000.0 - (t_core2sym - t_core2sym_before)); // core reported apart
             }
 
             Syft::Stopwatch tau2sym;
             tau2sym.start();
 
-            // add tautology to the product forming each game arena
-            ExplicitStateDfa no_empty_dfa = ExplicitStateDfa::from_dfa_mona(var_mgr_, mona_no_empty_dfa);
-            SymbolicStateDfa no_empty_sym_dfa = SymbolicStateDfa::from_explicit(std::move(no_empty_dfa));
+            // add tautology to the product forming each game arena, shared with the arenas of the environment restrictions
+            const SymbolicStateDfa& no_empty_sym_dfa = environment_cache_->non_empty_traces_dfa();
             for(int i = 0; i < mona_conjuncts_dfas.size(); ++i) symbolic_dfas_[i].push_back(no_empty_sym_dfa);
 
             // symbolic_dfas_.push_back(SymbolicStateDfa::from_explicit(std::move(no_empty_dfa)));
@@ -164,7 +221,7 @@ namespace Syft {
             //     symbolic_dfas_.push_back(SymbolicStateDfa::from_explicit(std::move(conjunct_dfas[i])));
             // }
             
-            // symbolic dfas are {\varphi, E_c, E'_1, E'_2, ..., E'_n, tt}
+            // symbolic dfas of arena i are {\varphi, E_c, E'_i, tt}, or {\varphi, E_c x E'_i, tt} if multiplied explicitly
             Syft::Stopwatch arena_time;
             arena_time.start();
 
@@ -184,35 +241,146 @@ namespace Syft {
             std::cout << "\t[cb-MtSyft] goal DFA to symbolic in " << t_goal2sym << " s" << std::endl;
             std::cout << "\t[cb-MtSyft] env core DFA to symbolic in " << t_core2sym << " s" << std::endl;
             for (int i = 0; i < t_conjunct2dfas.size(); ++i) {
-                std::cout << "\t[cb-MtSyft] env conjunct DFA " << i+1 << " to symbolic in " << t_conjunct2dfas[i] << " s" << std::endl;
+                if (multiplied[i]) std::cout << "\t[cb-MtSyft] env core x conjunct " << i+1 << " multiplied explicitly and symbolized in " << t_conjunct2dfas[i] << " s (" << var_mgr_->state_variable_count(symbolic_dfas_[i][1].automaton_id()) << " state variables)" << std::endl;
+                else std::cout << "\t[cb-MtSyft] env conjunct DFA " << i+1 << " to symbolic in " << t_conjunct2dfas[i] << " s" << std::endl;
             }
-            std::cout << "\t[cb-MtSyft] tautology DFA to symbolic in " << t_tau2dfa << std::endl;
+            std::cout << "\t[cb-MtSyft] tautology DFA to symbolic in " << t_tau2sym << " s" << std::endl;
+            std::cout << "\t[cb-MtSyft] DFAs reused: " << ConjunctiveDfa::memo_hits() - memo_hits_before << " translations, " << environment_cache_->dfa_hits() - dfa_hits_before << " symbolizations" << std::endl;
             for (int i = 0; i < t_arena.size(); ++i) std::cout << "\t[cb-MtSyft] arena " << i + 1 << " constructed in " << t_arena[i] << " s" <<  std::endl;
         }
 
         ChainedStrategies CommonCoreChainSynthesizer::run() {
-            
-            std::cout << "[cb-MtSyft] constructing and solving games...";
             ChainedStrategies result;
 
+            if (timed_out_) {
+                result.timed_out = true;
+                return result;
+            }
+
+            Syft::Stopwatch games;
+            games.start();
+            double construction_time = std::accumulate(run_times_.begin(), run_times_.end(), 0.0);
+
+            try {
+                solve_games(result);
+            } catch (const DeadlineExceeded& e) {
+                timed_out_ = true;
+                result.timed_out = true;
+                run_times_.push_back(construction_time + games.stop().count() / 1000.0 -
+                    std::accumulate(run_times_.begin(), run_times_.end(), 0.0)); // interrupted phase
+                std::cout << std::endl << "[cb-MtSyft] timeout while solving the games (" << e.what() << ")" << std::endl;
+            }
+
+            return result;
+        }
+
+        void CommonCoreChainSynthesizer::set_tier_solving(TierSolving tier_solving) {
+            tier_solving_ = tier_solving;
+        }
+
+        void CommonCoreChainSynthesizer::set_arena_minimization(bool minimize_arenas) {
+            minimize_arenas_ = minimize_arenas;
+        }
+
+        std::string CommonCoreChainSynthesizer::product_formula(int i) const {
+            return "(" + env_core_ + ") && (" + conjuncts_[i] + ")";
+        }
+
+        CUDD::BDD CommonCoreChainSynthesizer::environment_final_states(int i) const {
+            CUDD::BDD final_states = var_mgr_->cudd_mgr()->bddOne();
+            for (int j = 1; j < symbolic_dfas_[i].size() - 1; ++j) final_states = final_states * symbolic_dfas_[i][j].final_states();
+            return final_states;
+        }
+
+        void CommonCoreChainSynthesizer::solve_games(ChainedStrategies& result) {
+            
+            ProfileSpan span("solving games", "tiers");
+
+            // minimization is counted with the adversarial games
             Syft::Stopwatch adv_games;
             adv_games.start();
 
-            // adversarial games
-            std::vector<double> t_adv_games;
+            if (minimize_arenas_) std::cout << "[cb-MtSyft] minimizing arenas...";
+
+            std::vector<double> t_minimization;
             for (int i = 0; i < arena_.size(); ++i) {
-                Syft::Stopwatch adv_game;
-                adv_game.start();
-                CUDD::BDD adversarial_goal = ((!(symbolic_dfas_[i][1].final_states() * symbolic_dfas_[i][2].final_states())) + symbolic_dfas_[i][0].final_states()) * (!arena_[i].initial_state_bdd());
-                ReachabilitySynthesizer adversarial_synthesizer(
-                    arena_[i],
-                    starting_player_,
-                    Player::Agent,
-                    adversarial_goal,
-                    var_mgr_->cudd_mgr()->bddOne());
-                result.adversarial_results.push_back(adversarial_synthesizer.run());
-                t_adv_games.push_back(adv_game.stop().count() / 1000.0);
+                Syft::Stopwatch minimization;
+                minimization.start();
+                if (minimize_arenas_) {
+                    // goal and environment (core x conjunct) final states are the labels of the games
+                    quotients_.push_back(BisimulationQuotient::minimize(
+                        arena_[i],
+                        {symbolic_dfas_[i][0].final_states(), environment_final_states(i)}));
+                } else {
+                    quotients_.push_back(BisimulationQuotient::identity(arena_[i]));
                 }
+                t_minimization.push_back(minimization.stop().count() / 1000.0);
+            }
+
+            if (minimize_arenas_) {
+                std::cout << "DONE (" << std::accumulate(t_minimization.begin(), t_minimization.end(), 0.0) << " s)" << std::endl;
+                for (int i = 0; i < quotients_.size(); ++i) {
+                    std::cout << "\t[cb-MtSyft] arena " << i+1 << " minimized from " << quotients_[i].reachable_state_count() << " reachable states to " << quotients_[i].block_count() << " in " << t_minimization[i] << " s ("
+                              << var_mgr_->state_variable_count(quotients_[i].dfa().automaton_id()) << " state variables instead of " << var_mgr_->state_variable_count(arena_[i].automaton_id()) << ")" << std::endl;
+                }
+            }
+
+            std::cout << "[cb-MtSyft] constructing and solving games...";
+
+            TierSolver tier_solver(
+                var_mgr_,
+                arena_.size(),
+                tier_solving_,
+                [this](int i) { // adversarial game
+                    // shared by the subgames and the game as a whole
+                    auto game_arena = std::make_shared<const GameArena>(quotients_[i].dfa());
+
+                    if (!minimize_arenas_ && IndependentSubgameSynthesizer::subgame_detection()) {
+                        // goal or a violated env DFA, after the first move (final states of the tautology)
+                        std::vector<CUDD::BDD> goal_terms = {symbolic_dfas_[i][0].final_states()};
+                        for (int j = 1; j < symbolic_dfas_[i].size() - 1; ++j) goal_terms.push_back(!symbolic_dfas_[i][j].final_states());
+                        goal_terms.push_back(var_mgr_->cudd_mgr()->bddZero());
+                        IndependentSubgameSynthesizer subgame_synthesizer(
+                            game_arena,
+                            symbolic_dfas_[i],
+                            goal_terms,
+                            symbolic_dfas_[i].back().final_states(),
+                            starting_player_,
+                            Player::Agent);
+                        if (subgame_synthesizer.decomposable()) return subgame_synthesizer.run();
+                    }
+
+                    CUDD::BDD adversarial_goal = ((!environment_final_states(i)) + symbolic_dfas_[i][0].final_states()) * (!arena_[i].initial_state_bdd());
+                    ReachabilitySynthesizer adversarial_synthesizer(
+                        game_arena,
+                        starting_player_,
+                        Player::Agent,
+                        quotients_[i].to_quotient(adversarial_goal),
+                        var_mgr_->cudd_mgr()->bddOne());
+                    return quotients_[i].from_quotient(adversarial_synthesizer.run());
+                },
+                [this](int i) { // restriction and cooperative game
+                    // negated env game, solved on core x conjunct x tautology only
+                    CUDD::BDD non_environment_winning_region = environment_cache_->violation_region(
+                        environments_[i],
+                        std::vector<SymbolicStateDfa>(symbolic_dfas_[i].begin() + 1, symbolic_dfas_[i].end() - 1),
+                        starting_player_);
+                    restricted_arena_.push_back(quotients_[i].restriction(non_environment_winning_region));
+
+                    CUDD::BDD cooperative_goal = environment_final_states(i) * symbolic_dfas_[i][0].final_states();
+                    CoOperativeReachabilitySynthesizer co_operative_reachability_synthesizer(
+                        restricted_arena_.back().dfa(),
+                        starting_player_,
+                        Player::Agent,
+                        restricted_arena_.back().to_quotient(cooperative_goal),
+                        var_mgr_->cudd_mgr()->bddOne()
+                    );
+                    return restricted_arena_.back().from_quotient(co_operative_reachability_synthesizer.run());
+                });
+
+            // adversarial games
+            std::vector<std::optional<double>> t_adv_games;
+            result.adversarial_results = tier_solver.solve_adversarial_games(t_adv_games);
 
             run_times_.push_back(adv_games.stop().count() / 1000.0);
 
@@ -220,44 +388,19 @@ namespace Syft {
             Syft::Stopwatch coop_games;
             coop_games.start();
 
-            std::vector<double> t_coop_games;
-            for (int i = 0; i < arena_.size(); ++i) {
-                Syft::Stopwatch coop_game;
-                coop_game.start();
-                // restriction
-                CUDD::BDD negated_env_goal = (!(symbolic_dfas_[i][1].final_states() * symbolic_dfas_[i][2].final_states())) * (!arena_[i].initial_state_bdd());
-                ReachabilitySynthesizer negated_environment_synthesizer(
-                    arena_[i],
-                    starting_player_,
-                    Player::Agent,
-                    negated_env_goal,
-                    var_mgr_->cudd_mgr()->bddOne()
-                );
-                SynthesisResult environment_result = negated_environment_synthesizer.run();
-                CUDD::BDD non_environment_winning_region = environment_result.winning_states;
-                restricted_arena_.push_back(arena_[i].get_restriction(non_environment_winning_region));
-
-                // cooperation
-                CUDD::BDD cooperative_goal = (symbolic_dfas_[i][1].final_states() * symbolic_dfas_[i][2].final_states()) * symbolic_dfas_[i][0].final_states();
-                CoOperativeReachabilitySynthesizer co_operative_reachability_synthesizer(
-                    restricted_arena_[i],
-                    starting_player_,
-                    Player::Agent,
-                    cooperative_goal,
-                    var_mgr_->cudd_mgr()->bddOne()
-                );
-                result.cooperative_results.push_back(co_operative_reachability_synthesizer.run());
-                t_coop_games.push_back(coop_game.stop().count() / 1000.0);
-            }
+            std::vector<std::optional<double>> t_coop_games;
+            result.cooperative_results = tier_solver.solve_cooperative_games(result.adversarial_results, t_coop_games);
 
             run_times_.push_back(coop_games.stop().count() / 1000.0);
             std::cout << "DONE (" << run_times_[2] + run_times_[3] << " s)"  << std::endl;
-            for (int i = 0; i < t_adv_games.size(); ++i)
-                std::cout << "\t[cb-MtSyft] adv game in env " << i + 1 << " solved in " << t_adv_games[i] << " s" << std::endl;
-            for (int i = 0; i < t_coop_games.size(); ++i)
-                std::cout << "\t[cb-MtSyft] coop game in env " << i + 1 << " solved in " << t_coop_games[i] << " s" << std::endl;
-
-            return result;
+            for (int i = 0; i < t_adv_games.size(); ++i) {
+                if (t_adv_games[i]) std::cout << "\t[cb-MtSyft] adv game in env " << i + 1 << " solved in " << *t_adv_games[i] << " s" << std::endl;
+                else std::cout << "\t[cb-MtSyft] adv game in env " << i + 1 << " decided by monotonicity" << std::endl;
+            }
+            for (int i = 0; i < t_coop_games.size(); ++i) {
+                if (t_coop_games[i]) std::cout << "\t[cb-MtSyft] coop game in env " << i + 1 << " solved in " << *t_coop_games[i] << " s" << std::endl;
+                else std::cout << "\t[cb-MtSyft] coop game in env " << i + 1 << " not solved" << std::endl;
+            }
         }
 
         void CommonCoreChainSynthesizer::realizability(const std::vector<Syft::SynthesisResult>& adv_results, const std::vector<Syft::SynthesisResult>& coop_results) const {
@@ -282,6 +425,10 @@ namespace Syft {
         std::cout << std::endl;
     }
 
+    bool CommonCoreChainSynthesizer::timed_out() const {
+        return timed_out_;
+    }
+
     std::vector<double> CommonCoreChainSynthesizer::get_run_times() const {
         return run_times_;
     }
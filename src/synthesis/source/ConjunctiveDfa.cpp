@@ -0,0 +1,153 @@
+#include "ConjunctiveDfa.h"
+
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+#include "FormulaSimplifier.h"
+
+namespace Syft {
+
+namespace {
+
+bool decomposed_construction = false;
+
+bool memoized_translation = true;
+
+// DFAs by the normal form of their formulas, shared by all the synthesizers
+std::mutex memo_mutex;
+std::unordered_map<std::string, ExplicitStateDfaMona> memo;
+std::size_t hits = 0;
+
+}
+
+void ConjunctiveDfa::set_decomposition(bool decompose) {
+  decomposed_construction = decompose;
+}
+
+bool ConjunctiveDfa::decomposition() {
+  return decomposed_construction;
+}
+
+void ConjunctiveDfa::set_memoization(bool memoize) {
+  std::lock_guard<std::mutex> lock(memo_mutex);
+
+  memoized_translation = memoize;
+
+  if (!memoize) {
+    memo.clear();
+  }
+}
+
+std::size_t ConjunctiveDfa::memo_hits() {
+  std::lock_guard<std::mutex> lock(memo_mutex);
+
+  return hits;
+}
+
+ConjunctiveDfa::ConjunctiveDfa(std::vector<std::string> formulas,
+                               std::vector<ExplicitStateDfaMona> conjuncts)
+  : formulas_(std::move(formulas)), conjuncts_(std::move(conjuncts)) {}
+
+ConjunctiveDfa ConjunctiveDfa::of_formula(const std::string& formula) {
+  std::vector<std::string> formulas;
+
+  if (decomposed_construction) {
+    formulas = FormulaSimplifier::top_level_conjuncts(formula);
+  } else {
+    formulas.push_back(formula);
+  }
+
+  std::vector<std::string> normal_forms;
+  for (const std::string& conjunct : formulas) {
+    normal_forms.push_back(FormulaSimplifier::normal_form(conjunct));
+  }
+
+  // The conjuncts missing from the memo are translated together, outside the
+  // lock, since a translation can take long
+  std::vector<std::optional<ExplicitStateDfaMona>> dfas(formulas.size());
+  std::vector<std::string> missing;
+  std::vector<std::string> missing_normal_forms;
+  {
+    std::lock_guard<std::mutex> lock(memo_mutex);
+
+    for (std::size_t i = 0; i < formulas.size(); ++i) {
+      auto it = memoized_translation ? memo.find(normal_forms[i]) : memo.end();
+
+      if (it != memo.end()) {
+        dfas[i].emplace(it->second);
+        ++hits;
+      } else if (std::find(missing_normal_forms.begin(),
+                           missing_normal_forms.end(), normal_forms[i]) ==
+                 missing_normal_forms.end()) {
+        missing.push_back(formulas[i]);
+        missing_normal_forms.push_back(normal_forms[i]);
+      }
+    }
+  }
+
+  std::vector<ExplicitStateDfaMona> translated;
+  if (missing.size() == 1) {
+    translated.push_back(ExplicitStateDfaMona::dfa_of_formula(missing[0]));
+  } else if (!missing.empty()) {
+    translated = ExplicitStateDfaMona::dfas_of_formulas(missing);
+  }
+
+  std::lock_guard<std::mutex> lock(memo_mutex);
+
+  std::vector<ExplicitStateDfaMona> conjuncts;
+  for (std::size_t i = 0; i < formulas.size(); ++i) {
+    if (!dfas[i]) {
+      std::size_t j = std::find(missing_normal_forms.begin(),
+                                missing_normal_forms.end(), normal_forms[i]) -
+                      missing_normal_forms.begin();
+      dfas[i].emplace(translated[j]);
+
+      if (memoized_translation) {
+        memo.emplace(normal_forms[i], translated[j]);
+      }
+    }
+
+    conjuncts.push_back(std::move(*dfas[i]));
+  }
+
+  return ConjunctiveDfa(std::move(normal_forms), std::move(conjuncts));
+}
+
+const std::vector<ExplicitStateDfaMona>& ConjunctiveDfa::conjuncts() const {
+  return conjuncts_;
+}
+
+std::vector<std::string> ConjunctiveDfa::names() const {
+  std::vector<std::string> names;
+
+  for (const ExplicitStateDfaMona& conjunct : conjuncts_) {
+    for (const std::string& name : conjunct.names) {
+      if (std::find(names.begin(), names.end(), name) == names.end()) {
+        names.push_back(name);
+      }
+    }
+  }
+
+  return names;
+}
+
+SymbolicStateDfa ConjunctiveDfa::to_symbolic(EnvironmentCache& cache) const {
+  std::vector<SymbolicStateDfa> symbolic_conjuncts;
+
+  for (std::size_t i = 0; i < conjuncts_.size(); ++i) {
+    cache.var_mgr()->check_deadline();
+
+    symbolic_conjuncts.push_back(cache.symbolic_dfa(formulas_[i],
+                                                    conjuncts_[i]));
+  }
+
+  if (symbolic_conjuncts.size() == 1) {
+    return symbolic_conjuncts[0];
+  }
+
+  return SymbolicStateDfa::product(symbolic_conjuncts);
+}
+
+}
@@ -0,0 +1,41 @@
+#include "Deadline.h"
+
+namespace Syft {
+
+DeadlineExceeded::DeadlineExceeded(const std::string& what)
+    : std::runtime_error(what) {}
+
+Deadline::Deadline()
+    : cancelled_(false), time_limited_(false) {}
+
+Deadline::Deadline(double seconds)
+    : cancelled_(false), time_limited_(true) {
+  expiry_ = std::chrono::steady_clock::now() +
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(seconds));
+}
+
+void Deadline::cancel() {
+  cancelled_ = true;
+}
+
+bool Deadline::expired() const {
+  return cancelled_ ||
+         (time_limited_ && std::chrono::steady_clock::now() >= expiry_);
+}
+
+void Deadline::check() const {
+  if (expired()) {
+    throw DeadlineExceeded("Deadline exceeded.");
+  }
+}
+
+int Deadline::termination_callback(const void* deadline) {
+  return static_cast<const Deadline*>(deadline)->expired();
+}
+
+void Deadline::termination_handler(std::string message) {
+  throw DeadlineExceeded("Deadline exceeded (" + message + ").");
+}
+
+}
@@ -2,62 +2,40 @@
 
 #include <cassert>
 
+#include "Profiler.h"
+
 namespace Syft {
 
 DfaGameSynthesizer::DfaGameSynthesizer(SymbolicStateDfa spec,
 				       Player starting_player,
                        Player protagonist_player)
-    : Synthesizer<SymbolicStateDfa>(spec)
+    : DfaGameSynthesizer(std::make_shared<const GameArena>(std::move(spec)),
+                         starting_player, protagonist_player) {}
+
+DfaGameSynthesizer::DfaGameSynthesizer(std::shared_ptr<const GameArena> arena,
+				       Player starting_player,
+                       Player protagonist_player)
+    : Synthesizer<SymbolicStateDfa>(arena->dfa())
     , starting_player_(starting_player)
-    , protagonist_player_(protagonist_player){
+    , protagonist_player_(protagonist_player)
+    , arena_(std::move(arena)) {
   var_mgr_ = spec_.var_mgr();
-  
-  // Make versions of the initial state and transition function that can be used
-  // with CUDD::BDD::Eval and CUDD::BDD::VectorCompose, respectively
-    // std::cout << "creating initial state vector..." << std::endl;
-  initial_vector_ = var_mgr_->make_eval_vector(spec_.automaton_id(),
-					       spec_.initial_state());
-    // std::cout << "DONE" << std::endl;
-    // std::cout << "creating transition function vector..." << std::endl;
-  transition_vector_ = var_mgr_->make_compose_vector(
-      spec_.automaton_id(), spec_.transition_function());
-    // std::cout << "DONE" << std::endl;
-  
-  CUDD::BDD input_cube = var_mgr_->input_cube();
-  CUDD::BDD output_cube = var_mgr_->output_cube();
 
   // quantify_independent_variables_ quantifies all variables that the outputs
   // don't depend on (input variables if the agent plays first, or no variables
   // if the environment plays first). quantify_non_state_variables_ quantifies
   // all remaining variables that are not state variables.
-  if (starting_player_ == Player::Environment) {
-      if (protagonist_player_ == Player::Environment) {
-          quantify_independent_variables_ = std::make_unique<Forall>(output_cube);
-          quantify_non_state_variables_ = std::make_unique<Exists>(input_cube);
-      } else {
-          quantify_independent_variables_ = std::make_unique<NoQuantification>();
-          quantify_non_state_variables_ = std::make_unique<ForallExists>(input_cube,
-                                                                         output_cube);
-      }
-  } else { // i.e. starting_player == Player::Agemt
-      if (protagonist_player_ == Player::Environment) {
-          quantify_independent_variables_ = std::make_unique<NoQuantification>();
-          quantify_non_state_variables_ = std::make_unique<ForallExists>(output_cube,
-                                                                         input_cube);
-      } else { // i.e. protagonist_player == Player::Agemt
-          quantify_independent_variables_ = std::make_unique<Forall>(input_cube);
-          quantify_non_state_variables_ = std::make_unique<Exists>(output_cube);
-      }
-  }
-
-
+  const GameQuantification& quantification =
+    arena_->quantification(starting_player_, protagonist_player_, false);
+  quantify_independent_variables_ = quantification.independent_variables;
+  quantify_non_state_variables_ = quantification.non_state_variables;
 }
 
 CUDD::BDD DfaGameSynthesizer::preimage(
     const CUDD::BDD& winning_states) const {
   // Transitions that move into a winning state
   CUDD::BDD winning_transitions =
-    winning_states.VectorCompose(transition_vector_);
+    winning_states.VectorCompose(arena_->transition_vector());
 
   // Quantify all variables that the outputs don't depend on
   return quantify_independent_variables_->apply(winning_transitions);
@@ -72,16 +50,32 @@ bool DfaGameSynthesizer::includes_initial_state(
     const CUDD::BDD& winning_states) const {
   // Need to create a copy if we want to define the function as const, since
   // CUDD::BDD::Eval does not take the data as const
-  std::vector<int> copy(initial_vector_);
+  std::vector<int> copy(arena_->initial_vector());
   
   return winning_states.Eval(copy.data()).IsOne();
 }
 
+ReachabilityArena DfaGameSynthesizer::reachability_arena(
+    const CUDD::BDD& goal_states, const CUDD::BDD& state_space) const {
+  ReachabilityArena arena;
+  arena.goal_states = goal_states;
+  // The codes that encode no state are don't-cares, see valid_states()
+  arena.state_space = state_space & spec_.valid_states();
+  arena.transition_vector = arena_->transition_vector();
+  arena.initial_vector = arena_->initial_vector();
+  arena.preimage_quantifiers = quantify_independent_variables_->quantifiers();
+  arena.projection_quantifiers = quantify_non_state_variables_->quantifiers();
+
+  return arena;
+}
+
 std::unordered_map<int, CUDD::BDD> DfaGameSynthesizer::synthesize_strategy(
     const CUDD::BDD& winning_moves) const {
+  ProfileSpan span("strategy extraction", "games");
+
   std::vector<CUDD::BDD> parameterized_output_function;
   int* output_indices;
-  CUDD::BDD output_cube = var_mgr_->output_cube();
+  CUDD::BDD output_cube = arena_->output_cube();
   std::size_t output_count = var_mgr_->output_variable_count();
 
   // Need to negate the BDD because b.SolveEqn(...) solves the equation b = 0
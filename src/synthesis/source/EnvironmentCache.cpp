@@ -0,0 +1,122 @@
+#include "EnvironmentCache.h"
+
+#include "ExplicitStateDfa.h"
+#include "FormulaSimplifier.h"
+#include "Profiler.h"
+#include "ReachabilitySynthesizer.h"
+
+namespace Syft {
+
+EnvironmentCache::EnvironmentCache(std::shared_ptr<VarMgr> var_mgr)
+  : var_mgr_(std::move(var_mgr)) {}
+
+std::shared_ptr<VarMgr> EnvironmentCache::var_mgr() const {
+  return var_mgr_;
+}
+
+const SymbolicStateDfa* EnvironmentCache::find_dfa(
+    const std::string& formula) const {
+  auto it = dfas_.find(FormulaSimplifier::normal_form(formula));
+
+  if (it == dfas_.end()) {
+    return nullptr;
+  }
+
+  return &it->second;
+}
+
+const SymbolicStateDfa& EnvironmentCache::insert_dfa(const std::string& formula,
+                                                     SymbolicStateDfa dfa) {
+  return dfas_.emplace(FormulaSimplifier::normal_form(formula), std::move(dfa))
+    .first->second;
+}
+
+const SymbolicStateDfa* EnvironmentCache::reuse_dfa(
+    const std::string& formula) {
+  const SymbolicStateDfa* dfa = find_dfa(formula);
+
+  if (dfa) {
+    ++dfa_hits_;
+  }
+
+  return dfa;
+}
+
+const SymbolicStateDfa& EnvironmentCache::symbolic_dfa(
+    const std::string& formula, const ExplicitStateDfaMona& explicit_dfa) {
+  if (const SymbolicStateDfa* dfa = reuse_dfa(formula)) {
+    return *dfa;
+  }
+
+  return insert_dfa(formula, SymbolicStateDfa::from_explicit(
+      ExplicitStateDfa::from_dfa_mona(var_mgr_, explicit_dfa)));
+}
+
+const SymbolicStateDfa& EnvironmentCache::non_empty_traces_dfa() {
+  if (!non_empty_traces_dfa_) {
+    ExplicitStateDfa explicit_dfa = ExplicitStateDfa::from_dfa_mona(
+        var_mgr_, ExplicitStateDfaMona::dfa_of_non_empty_traces());
+    non_empty_traces_dfa_ = std::make_unique<SymbolicStateDfa>(
+        SymbolicStateDfa::from_explicit(explicit_dfa));
+  }
+
+  return *non_empty_traces_dfa_;
+}
+
+CUDD::BDD EnvironmentCache::violation_region(
+    const std::vector<std::string>& environment,
+    const std::vector<SymbolicStateDfa>& dfas,
+    Player starting_player) {
+  std::vector<std::string> normal_forms;
+  for (const std::string& formula : environment) {
+    normal_forms.push_back(FormulaSimplifier::normal_form(formula));
+  }
+
+  auto key = std::make_pair(std::move(normal_forms), starting_player);
+  auto it = regions_.find(key);
+
+  if (it != regions_.end()) {
+    ++region_hits_;
+    return it->second;
+  }
+
+  ProfileSpan span("environment restriction", "tiers", "tiers",
+                   environment.size());
+
+  CUDD::BDD environment_final_states = var_mgr_->cudd_mgr()->bddOne();
+  std::vector<SymbolicStateDfa> arena_dfas = dfas;
+
+  for (const SymbolicStateDfa& dfa : dfas) {
+    environment_final_states &= dfa.final_states();
+  }
+
+  arena_dfas.push_back(non_empty_traces_dfa());
+  SymbolicStateDfa arena = SymbolicStateDfa::product(arena_dfas);
+
+  // The initial state of the DFA of non-empty traces is never visited again,
+  // so excluding the initial state of this arena excludes the same reachable
+  // states as excluding that of the full arena
+  CUDD::BDD negated_environment_goal =
+    !environment_final_states * !arena.initial_state_bdd();
+
+  ReachabilitySynthesizer synthesizer(arena,
+                                      starting_player,
+                                      Player::Agent,
+                                      negated_environment_goal,
+                                      var_mgr_->cudd_mgr()->bddOne());
+  CUDD::BDD region = synthesizer.run().winning_states;
+
+  regions_.emplace(std::move(key), region);
+
+  return region;
+}
+
+std::size_t EnvironmentCache::region_hits() const {
+  return region_hits_;
+}
+
+std::size_t EnvironmentCache::dfa_hits() const {
+  return dfa_hits_;
+}
+
+}
@@ -6,15 +6,42 @@
 */
 
 #include"EnvironmentsChainBestEffortSynthesizer.h"
+#include"ConjunctiveDfa.h"
+#include"Profiler.h"
+
+#include<numeric>
+#include<optional>
 
 namespace Syft {
 
-    EnvironmentsChainBestEffortSynthesizer::EnvironmentsChainBestEffortSynthesizer(std::shared_ptr<VarMgr> var_mgr, std::string ltlf_goal, std::vector<std::string> ltlf_envs, Syft::InputOutputPartition partition, Syft::Player starting_player) : 
+    EnvironmentsChainBestEffortSynthesizer::EnvironmentsChainBestEffortSynthesizer(std::shared_ptr<VarMgr> var_mgr, std::string ltlf_goal, std::vector<std::string> ltlf_envs, Syft::InputOutputPartition partition, Syft::Player starting_player, std::shared_ptr<EnvironmentCache> environment_cache) : 
         var_mgr_(var_mgr),
         ltlf_goal_(ltlf_goal),
         ltlf_envs_(ltlf_envs),
         partition_(partition),
-        starting_player_(starting_player) {
+        starting_player_(starting_player),
+        environment_cache_(environment_cache ? environment_cache : std::make_shared<EnvironmentCache>(var_mgr)) {
+            if (environment_cache_->var_mgr() != var_mgr_) {
+                throw std::runtime_error("Error: The environment cache belongs to another variable manager.");
+            }
+
+            Syft::Stopwatch construction;
+            construction.start();
+
+            try {
+                construct_arenas();
+            } catch (const DeadlineExceeded& e) {
+                timed_out_ = true;
+                run_times_.push_back(construction.stop().count() / 1000.0 -
+                    std::accumulate(run_times_.begin(), run_times_.end(), 0.0)); // interrupted phase
+                std::cout << std::endl << "[MtSyft] timeout while constructing the game arenas (" << e.what() << ")" << std::endl;
+            }
+    }
+
+    void EnvironmentsChainBestEffortSynthesizer::construct_arenas() {
+            // translations and symbolizations saved by the memoized DFAs
+            std::size_t memo_hits_before = ConjunctiveDfa::memo_hits();
+            std::size_t dfa_hits_before = environment_cache_->dfa_hits();
 
             // debug
             // std::cout << "Agent goal: " << ltlf_goal_ << std::endl;
@@ -32,24 +59,20 @@ namespace Syft {
 
             Syft::Stopwatch goal2dfa;
             goal2dfa.start();
-            ExplicitStateDfaMona mona_goal_dfa =
-                ExplicitStateDfaMona::dfa_of_formula(ltlf_goal_);
+            ConjunctiveDfa mona_goal_dfa =
+                ConjunctiveDfa::of_formula(ltlf_goal_);
             ltlf2dfa_times.push_back(goal2dfa.stop().count() / 1000.0);
             
-            std::vector<ExplicitStateDfaMona> mona_env_dfas; // leftmost is the most determinate. Rightmost the less determinate
+            std::vector<std::optional<ConjunctiveDfa>> mona_env_dfas; // leftmost is the most determinate. Rightmost the less determinate
             for (const auto& env: ltlf_envs_) {
+                var_mgr_->check_deadline();
                 Syft::Stopwatch env2dfa;
                 env2dfa.start();
-                mona_env_dfas.push_back(ExplicitStateDfaMona::dfa_of_formula(env));            
+                if (environment_cache_->reuse_dfa(env)) mona_env_dfas.emplace_back(); // symbolic DFA already cached
+                else mona_env_dfas.push_back(ConjunctiveDfa::of_formula(env));
                 ltlf2dfa_times.push_back(env2dfa.stop().count() / 1000.0);
             }
 
-            Syft::Stopwatch tau2dfa;
-            tau2dfa.start();
-            ExplicitStateDfaMona mona_no_empty_dfa =
-                ExplicitStateDfaMona::dfa_of_formula("F(true)"); // accepts non-empty traces only
-            double t_tau2dfa = tau2dfa.stop().count() / 1000.0;
-
             // debug
             // std::cout << "No-empty traces DFA: ";
             // mona_no_empty_dfa.dfa_print();
@@ -63,7 +86,6 @@ namespace Syft {
             for (int i = 1; i < ltlf2dfa_times.size(); ++i) {
                 std::cout << "\t[MtSyft] environment " << i << " to DFA in " << ltlf2dfa_times[i] << " s" << std::endl;
             }
-            std::cout << "\t[MtSyft] tautology to DFA in " << t_tau2dfa << " s" << std::endl;
 
             // debug
             // mona_goal_dfa.dfa_print();
@@ -96,9 +118,13 @@ namespace Syft {
             
             // Rewrites the preprocessing phase to not use the SPOT parser
             // which does not interact well with Lydia (does not support Lydia's X[!])
-            var_mgr_->create_named_variables(mona_goal_dfa.names);
-            for (const auto& env_dfa : mona_env_dfas) var_mgr_->create_named_variables(env_dfa.names);
+            var_mgr_->create_named_variables(mona_goal_dfa.names());
+            for (const auto& env_dfa : mona_env_dfas) if (env_dfa) var_mgr_->create_named_variables(env_dfa->names());
 
+            // also the variables that no formula mentions, e.g., after the
+            // simplification of the formulas
+            var_mgr_->create_named_variables(partition_.input_variables);
+            var_mgr_->create_named_variables(partition_.output_variables);
             var_mgr_->partition_variables(partition_.input_variables,
                                         partition_.output_variables);
 
@@ -111,10 +137,7 @@ namespace Syft {
             Syft::Stopwatch goal2sym;
             goal2sym.start();
 
-            ExplicitStateDfa goal_dfa =
-                ExplicitStateDfa::from_dfa_mona(var_mgr_, mona_goal_dfa);
-            SymbolicStateDfa goal_sym_dfa =
-                SymbolicStateDfa::from_explicit(std::move(goal_dfa));
+            SymbolicStateDfa goal_sym_dfa = mona_goal_dfa.to_symbolic(*environment_cache_);
 
             // add goal symbolic DFA to all products for game arenas
             for (int i = 0; i < mona_env_dfas.size(); ++i) {
@@ -126,14 +149,14 @@ namespace Syft {
 
             std::vector<double> t_env2sym;
 
-            std::vector<ExplicitStateDfa> env_dfas;
-
             for (int i = 0; i < mona_env_dfas.size(); ++i) {
                 Syft::Stopwatch env2sym;
                 env2sym.start();
 
-                env_dfas.push_back(ExplicitStateDfa::from_dfa_mona(var_mgr_, mona_env_dfas[i]));
-                symbolic_dfas_[i].push_back(SymbolicStateDfa::from_explicit(std::move(env_dfas[i]))); // add each E_i to the corresponding product vector
+                if (mona_env_dfas[i]) {
+                    environment_cache_->insert_dfa(ltlf_envs_[i], mona_env_dfas[i]->to_symbolic(*environment_cache_));
+                }
+                symbolic_dfas_[i].push_back(*environment_cache_->find_dfa(ltlf_envs_[i])); // add each E_i to the corresponding product vector
 
                 t_env2sym.push_back(env2sym.stop().count() / 1000.0);
             }
@@ -141,9 +164,8 @@ namespace Syft {
             Syft::Stopwatch tau2sym;
             tau2sym.start();
 
-            // tautology symbolic DFA
-            ExplicitStateDfa no_empty_dfa = ExplicitStateDfa::from_dfa_mona(var_mgr_, mona_no_empty_dfa);
-            SymbolicStateDfa tau_sym_dfa = SymbolicStateDfa::from_explicit(std::move(no_empty_dfa));
+            // tautology symbolic DFA, shared with the arenas of the environment restrictions
+            const SymbolicStateDfa& tau_sym_dfa = environment_cache_->non_empty_traces_dfa();
 
             // add tautology to the product forming each arena
             for (int i = 0; i < mona_env_dfas.size(); ++i) {
@@ -174,6 +196,7 @@ namespace Syft {
                 std::cout << "\t[MtSyft] environment " << i+1 << " to symbolic in " << t_env2sym[i] << " s" << std::endl;
             }
             std::cout << "\t[MtSyft] tautology DFA to symbolic in " << t_tau2sym << " s" << std::endl;
+            std::cout << "\t[MtSyft] DFAs reused: " << ConjunctiveDfa::memo_hits() - memo_hits_before << " translations, " << environment_cache_->dfa_hits() - dfa_hits_before << " symbolizations" << std::endl;
             std::cout << "\t[MtSyft] symbolic arenas constructed in " << arena_stop << " s" << std::endl;
             for (int i = 0; i < t_arena.size(); ++i) {
                 std::cout << "\t\t[MtSyft] arena " << i+1 << " constructed in " << t_arena[i] << " s" << std::endl;
@@ -182,28 +205,124 @@ namespace Syft {
 
     // std::pair<std::vector<SynthesisResult>, std::vector<SynthesisResult>> EnvironmentsChainBestEffortSynthesizer::run() {
     ChainedStrategies EnvironmentsChainBestEffortSynthesizer::run() {
-    
-            std::cout << "[MtSyft] constructing and solving games...";
             ChainedStrategies result;
 
+            if (timed_out_) {
+                result.timed_out = true;
+                return result;
+            }
+
+            Syft::Stopwatch games;
+            games.start();
+            double construction_time = std::accumulate(run_times_.begin(), run_times_.end(), 0.0);
+
+            try {
+                solve_games(result);
+            } catch (const DeadlineExceeded& e) {
+                timed_out_ = true;
+                result.timed_out = true;
+                run_times_.push_back(construction_time + games.stop().count() / 1000.0 -
+                    std::accumulate(run_times_.begin(), run_times_.end(), 0.0)); // interrupted phase
+                std::cout << std::endl << "[MtSyft] timeout while solving the games (" << e.what() << ")" << std::endl;
+            }
+
+            return result;
+    }
+
+    void EnvironmentsChainBestEffortSynthesizer::set_tier_solving(TierSolving tier_solving) {
+        tier_solving_ = tier_solving;
+    }
+
+    void EnvironmentsChainBestEffortSynthesizer::set_arena_minimization(bool minimize_arenas) {
+        minimize_arenas_ = minimize_arenas;
+    }
+
+    void EnvironmentsChainBestEffortSynthesizer::solve_games(ChainedStrategies& result) {
+    
+            ProfileSpan span("solving games", "tiers");
+
+            // minimization is counted with the adversarial games
             Syft::Stopwatch adv_games;
             adv_games.start();
 
-            // adversarial games
-            std::vector<double> t_adv_games;
+            if (minimize_arenas_) std::cout << "[MtSyft] minimizing arenas...";
+
+            std::vector<double> t_minimization;
             for (int i = 0; i < arena_.size(); ++i) {
-                Syft::Stopwatch adv_game;
-                adv_game.start();
-                CUDD::BDD adversarial_goal = ((!symbolic_dfas_[i][1].final_states()) + symbolic_dfas_[i][0].final_states()) * (!arena_[i].initial_state_bdd());
-                ReachabilitySynthesizer adversarial_synthesizer(
-                    arena_[i],
-                    starting_player_,
-                    Player::Agent,
-                    adversarial_goal,
-                    var_mgr_->cudd_mgr()->bddOne());
-                result.adversarial_results.push_back(adversarial_synthesizer.run());
-                t_adv_games.push_back(adv_game.stop().count() / 1000.0);
+                Syft::Stopwatch minimization;
+                minimization.start();
+                if (minimize_arenas_) {
+                    // goal and environment final states are the labels of the games
+                    quotients_.push_back(BisimulationQuotient::minimize(
+                        arena_[i],
+                        {symbolic_dfas_[i][0].final_states(), symbolic_dfas_[i][1].final_states()}));
+                } else {
+                    quotients_.push_back(BisimulationQuotient::identity(arena_[i]));
+                }
+                t_minimization.push_back(minimization.stop().count() / 1000.0);
+            }
+
+            if (minimize_arenas_) {
+                std::cout << "DONE (" << std::accumulate(t_minimization.begin(), t_minimization.end(), 0.0) << " s)" << std::endl;
+                for (int i = 0; i < quotients_.size(); ++i) {
+                    std::cout << "\t[MtSyft] arena " << i+1 << " minimized from " << quotients_[i].reachable_state_count() << " reachable states to " << quotients_[i].block_count() << " in " << t_minimization[i] << " s ("
+                              << var_mgr_->state_variable_count(quotients_[i].dfa().automaton_id()) << " state variables instead of " << var_mgr_->state_variable_count(arena_[i].automaton_id()) << ")" << std::endl;
                 }
+            }
+
+            std::cout << "[MtSyft] constructing and solving games...";
+
+            TierSolver tier_solver(
+                var_mgr_,
+                arena_.size(),
+                tier_solving_,
+                [this](int i) { // adversarial game
+                    // shared by the subgames and the game as a whole
+                    auto game_arena = std::make_shared<const GameArena>(quotients_[i].dfa());
+
+                    if (!minimize_arenas_ && IndependentSubgameSynthesizer::subgame_detection()) {
+                        // goal or violated env, after the first move (final states of the tautology)
+                        IndependentSubgameSynthesizer subgame_synthesizer(
+                            game_arena,
+                            symbolic_dfas_[i],
+                            {symbolic_dfas_[i][0].final_states(), !symbolic_dfas_[i][1].final_states(), var_mgr_->cudd_mgr()->bddZero()},
+                            symbolic_dfas_[i][2].final_states(),
+                            starting_player_,
+                            Player::Agent);
+                        if (subgame_synthesizer.decomposable()) return subgame_synthesizer.run();
+                    }
+
+                    CUDD::BDD adversarial_goal = ((!symbolic_dfas_[i][1].final_states()) + symbolic_dfas_[i][0].final_states()) * (!arena_[i].initial_state_bdd());
+                    ReachabilitySynthesizer adversarial_synthesizer(
+                        game_arena,
+                        starting_player_,
+                        Player::Agent,
+                        quotients_[i].to_quotient(adversarial_goal),
+                        var_mgr_->cudd_mgr()->bddOne());
+                    return quotients_[i].from_quotient(adversarial_synthesizer.run());
+                },
+                [this](int i) { // restriction and cooperative game
+                    // negated env game, solved on env x tautology only
+                    CUDD::BDD non_environment_winning_region = environment_cache_->violation_region(
+                        {ltlf_envs_[i]},
+                        {symbolic_dfas_[i][1]},
+                        starting_player_);
+                    restricted_arena_.push_back(quotients_[i].restriction(non_environment_winning_region));
+
+                    CUDD::BDD cooperative_goal = symbolic_dfas_[i][1].final_states() * symbolic_dfas_[i][0].final_states();
+                    CoOperativeReachabilitySynthesizer co_operative_reachability_synthesizer(
+                        restricted_arena_.back().dfa(),
+                        starting_player_,
+                        Player::Agent,
+                        restricted_arena_.back().to_quotient(cooperative_goal),
+                        var_mgr_->cudd_mgr()->bddOne()
+                    );
+                    return restricted_arena_.back().from_quotient(co_operative_reachability_synthesizer.run());
+                });
+
+            // adversarial games
+            std::vector<std::optional<double>> t_adv_games;
+            result.adversarial_results = tier_solver.solve_adversarial_games(t_adv_games);
 
             run_times_.push_back(adv_games.stop().count() / 1000.0);
 
@@ -211,44 +330,20 @@ namespace Syft {
             Syft::Stopwatch coop_games;
             coop_games.start();
 
-            std::vector<double> t_coop_games;
-            for (int i = 0; i < arena_.size(); ++i) {
-                Syft::Stopwatch coop_game;
-                coop_game.start();
-                // restriction
-                CUDD::BDD negated_env_goal = (!symbolic_dfas_[i][1].final_states()) * (!arena_[i].initial_state_bdd());
-                ReachabilitySynthesizer negated_environment_synthesizer(
-                    arena_[i],
-                    starting_player_,
-                    Player::Agent,
-                    negated_env_goal,
-                    var_mgr_->cudd_mgr()->bddOne()
-                );
-                SynthesisResult environment_result = negated_environment_synthesizer.run();
-                CUDD::BDD non_environment_winning_region = environment_result.winning_states;
-                restricted_arena_.push_back(arena_[i].get_restriction(non_environment_winning_region));
-
-                // cooperation
-                CUDD::BDD cooperative_goal = symbolic_dfas_[i][1].final_states() * symbolic_dfas_[i][0].final_states();
-                CoOperativeReachabilitySynthesizer co_operative_reachability_synthesizer(
-                    restricted_arena_[i],
-                    starting_player_,
-                    Player::Agent,
-                    cooperative_goal,
-                    var_mgr_->cudd_mgr()->bddOne()
-                );
-                result.cooperative_results.push_back(co_operative_reachability_synthesizer.run());
-                t_coop_games.push_back(coop_game.stop().count() / 1000.0);
-            }
+            std::vector<std::optional<double>> t_coop_games;
+            result.cooperative_results = tier_solver.solve_cooperative_games(result.adversarial_results, t_coop_games);
 
             run_times_.push_back(coop_games.stop().count() / 1000.0);
             std::cout << "DONE (" << run_times_[2] + run_times_[3] << " s)"  << std::endl;
-            for (int i = 0; i < t_adv_games.size(); ++i)
-                std::cout << "\t[MtSyft] adv game in env " << i + 1 << " solved in " << t_adv_games[i] << " s" << std::endl;
-            for (int i = 0; i < t_coop_games.size(); ++i)
-                std::cout << "\t[MtSyft] coop game in env " << i + 1 << " solved in " << t_coop_games[i] << " s" << std::endl;
+            for (int i = 0; i < t_adv_games.size(); ++i) {
+                if (t_adv_games[i]) std::cout << "\t[MtSyft] adv game in env " << i + 1 << " solved in " << *t_adv_games[i] << " s" << std::endl;
+                else std::cout << "\t[MtSyft] adv game in env " << i + 1 << " decided by monotonicity" << std::endl;
+            }
+            for (int i = 0; i < t_coop_games.size(); ++i) {
+                if (t_coop_games[i]) std::cout << "\t[MtSyft] coop game in env " << i + 1 << " solved in " << *t_coop_games[i] << " s" << std::endl;
+                else std::cout << "\t[MtSyft] coop game in env " << i + 1 << " not solved" << std::endl;
+            }
 
-            return result;
     }
 
 
@@ -269,7 +364,6 @@ namespace Syft {
         }
 
         std::cout << "DONE" << std::endl;
-
     }
 
     void EnvironmentsChainBestEffortSynthesizer::realizability(const std::vector<Syft::SynthesisResult>& adv_results, const std::vector<Syft::SynthesisResult>& coop_results) const {
@@ -306,7 +400,8 @@ namespace Syft {
         // INITIAL STATE
         // order of variables is (X \/ Y, Z_{G}, Z_{E_1}, ..., Z_{E_n}, Z_{tt})
         std::vector<int> state, goal_init = symbolic_dfas_[0][0].initial_state(), tau_init = symbolic_dfas_[0][2].initial_state();
-        for (int i = 0; i < var_mgr_->get_index_to_name().size(); ++i) state.push_back(0); // X \/ Y vars are 0 at the initial state
+        std::size_t named_variable_count = var_mgr_->named_variable_count(); // X \/ Y vars have indices 0, ..., named_variable_count - 1
+        for (int i = 0; i < named_variable_count; ++i) state.push_back(0); // X \/ Y vars are 0 at the initial state
         state.insert(state.end(), goal_init.begin(), goal_init.end()); // Z_{G}
         for (int i = 0; i < symbolic_dfas_.size(); ++i) {
           std::vector<int> env_init = symbolic_dfas_[i][1].initial_state();
@@ -318,28 +413,23 @@ namespace Syft {
         // for (const auto& b : state) std::cout << b;
         // std::cout << ". Size: " << state.size()  << std::endl;
 
+        // winning regions and strategies of all tiers, folded into single diagrams
+        TierMap tier_map(var_mgr_, adversarial_result, cooperative_result);
+
         if (starting_player_==Player::Agent) {
         bool running = true;
         int least_valid_env = 0;
         while (running) {
-            // determines maximum env with winning output
-            int max_win = -1, min_coop = -1;
-            for (int i = symbolic_dfas_.size() - 1; i >= least_valid_env; --i) {
-                CUDD::BDD winning_region = adversarial_result[i].winning_states;
-                if (winning_region.Eval(state.data()).IsOne()) {max_win = i; break;}    
-            }
-            // determines minimum env with coopearive output (which is not winning)
-            for (int i = max_win+1; i < symbolic_dfas_.size(); ++i) {
-                CUDD::BDD cooperative_region = cooperative_result[i].winning_states;
-                if (cooperative_region.Eval(state.data()).IsOne()) {min_coop = i; break;}
-            }
+            // determines maximum env with winning output and minimum env with
+            // cooperative output (which is not winning)
+            TierSelection selection = tier_map.select(state, least_valid_env);
+            int max_win = selection.max_win, min_coop = selection.min_coop;
 
             std::cout << "[MtSyft][interactive] Max win: " << max_win+1 << ". Min coop: " << min_coop+1 << std::endl;
 
             // gets output function
-            std::unordered_map<int, CUDD::BDD> output_function;
-            if (max_win >= 0) output_function = adversarial_result[max_win].transducer.get()->get_output_function();
-            else if (max_win < 0 && min_coop >= 0) output_function = cooperative_result[min_coop].transducer.get()->get_output_function();
+            const std::unordered_map<int, CUDD::BDD>* output_function;
+            if (max_win >= 0 || min_coop >= 0) output_function = &tier_map.output_function(selection);
             else {
                 // output_function = cooperative_result[0].transducer.get()->get_output_function(); // i.e. any output is best-effort
                 std::cout << "[MtSyft][interactive] Losing region reached. Terminating" << std::endl;
@@ -349,15 +439,13 @@ namespace Syft {
 
             // agent moves first
             std::vector<int> transition = state; //
-            std::unordered_map<int, std::string> id_to_var = var_mgr_->get_index_to_name();
             std::cout << "[MtSyft][interactive] agent choice: " << std::endl;
-            for(int i = 0; i < id_to_var.size(); ++i) {
-                std::string var = id_to_var[i];
+            for(int i = 0; i < named_variable_count; ++i) {
                 int agent_eval;
-                if (var_mgr_->is_output_variable(var)) {
-                    std::cout << "Variable: " << var;
+                if (var_mgr_->variable_info(i).role == VariableRole::Output) {
+                    std::cout << "Variable: " << var_mgr_->index_to_name(i);
                     std::cout << ". Agent output (0=false, 1=true): ";
-                    agent_eval = output_function[i].Eval(state.data()).IsOne();
+                    agent_eval = output_function->at(i).Eval(state.data()).IsOne();
                     std::cout << agent_eval << std::endl;
                     transition[i] = agent_eval;
                 }
@@ -365,11 +453,10 @@ namespace Syft {
 
             // environment turn
             std::cout << "[MtSyft][interactive] environment choice (type 1 if var is true, else 0): " << std::endl;
-            for (int i = 0; i < id_to_var.size(); ++i) {
-                std::string var = id_to_var[i];
+            for (int i = 0; i < named_variable_count; ++i) {
                 int env_eval;
-                if (var_mgr_->is_input_variable(var)) {
-                    std::cout << "Variable: " << var;
+                if (var_mgr_->variable_info(i).role == VariableRole::Input) {
+                    std::cout << "Variable: " << var_mgr_->index_to_name(i);
                     std::cout << ". Env Input (0=false, 1=true): ";
                     std::cin >> env_eval;
                     transition[i] = env_eval;
@@ -387,7 +474,7 @@ namespace Syft {
             std::cout << std::endl;
 
             // successor state
-            int curr_state_var = id_to_var.size();
+            int curr_state_var = named_variable_count;
             // std::cout << "Current state variable: " << curr_state_var << std::endl;
             std::vector<int> new_state = state;
             for(int i = 0; i < symbolic_dfas_[0][0].transition_function().size(); ++i) {
@@ -436,6 +523,10 @@ namespace Syft {
         }   
     }
 
+    bool EnvironmentsChainBestEffortSynthesizer::timed_out() const {
+        return timed_out_;
+    }
+
     std::vector<double> EnvironmentsChainBestEffortSynthesizer::get_run_times() const {
         return run_times_;
     }
@@ -1,193 +1,308 @@
 #include "ExplicitStateDfa.h"
+#include "Profiler.h"
 
 #include <algorithm>
-#include <fstream>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
 
-#include <boost/algorithm/string/classification.hpp>
-#include <boost/algorithm/string/split.hpp>
-#include <boost/algorithm/string/trim.hpp>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace Syft {
 
-ExplicitStateDfa::ExplicitStateDfa(std::shared_ptr<VarMgr> var_mgr)
-  : var_mgr_(std::move(var_mgr))
-{}
+namespace {
 
-std::runtime_error ExplicitStateDfa::bad_file_format_exception(
-    std::size_t line_number) {
-  return std::runtime_error("Incorrect format in line " +
-			    std::to_string(line_number) +
-			    " of the DFA file.");
-}
+/**
+ * \brief A read-only memory mapping of a whole file.
+ */
+class MappedFile {
+ private:
 
-std::vector<std::string> ExplicitStateDfa::read_mona_line(
-    std::istream& in,
-    std::size_t line_number) {
-  std::string line;
-  std::getline(in, line);
+  void* data_ = MAP_FAILED;
+  std::size_t size_ = 0;
 
-  std::vector<std::string> substr;
-  boost::split(substr, line, boost::is_any_of(":"));
+ public:
 
-  if (substr.size() != 2) {
-    throw bad_file_format_exception(line_number);
-  }
+  explicit MappedFile(const std::string& filename) {
+    int fd = open(filename.c_str(), O_RDONLY);
 
-  return substr;
-}
+    if (fd == -1) {
+      throw std::runtime_error("Error: Could not open " + filename + ": " +
+                               std::strerror(errno));
+    }
 
-std::vector<std::string> ExplicitStateDfa::read_variable_names(
-    std::istream& in,
-    std::size_t line_number) {
-  std::vector<std::string> substr = read_mona_line(in, line_number);
-  
-  if (substr[0] != "variables") {
-    throw bad_file_format_exception(line_number);
-  }
+    struct stat file_status;
+    if (fstat(fd, &file_status) == -1) {
+      close(fd);
+      throw std::runtime_error("Error: Could not stat " + filename + ": " +
+                               std::strerror(errno));
+    }
 
-  std::vector<std::string> variables;
-  boost::trim(substr[1]); // remove leading and trailing whitespace
-  boost::split(variables, substr[1], boost::is_any_of(" "));
-  
-  return variables;
-}
+    size_ = file_status.st_size;
 
-std::size_t ExplicitStateDfa::read_state_count(std::istream& in,
-						      std::size_t line_number) {
-  std::vector<std::string> substr = read_mona_line(in, line_number);
-  
-  if (substr[0] != "states") {
-    throw bad_file_format_exception(line_number);
-  }
-  
-  try {
-    return std::stoi(substr[1]);
+    // mmap rejects empty mappings; an empty file is simply an empty view
+    if (size_ > 0) {
+      data_ = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+
+    close(fd);
+
+    if (size_ > 0 && data_ == MAP_FAILED) {
+      throw std::runtime_error("Error: Could not map " + filename + ": " +
+                               std::strerror(errno));
+    }
+
+    if (size_ > 0) {
+      madvise(data_, size_, MADV_SEQUENTIAL);
+    }
   }
-  catch (const std::exception& e) {
-    throw bad_file_format_exception(line_number);
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  ~MappedFile() {
+    if (data_ != MAP_FAILED) {
+      munmap(data_, size_);
+    }
   }
-}
 
-std::vector<std::size_t> ExplicitStateDfa::read_final_states(
-    std::istream& in,
-    std::size_t line_number) {
-  std::vector<std::string> substr = read_mona_line(in, line_number);
-  
-  if (substr[0] != "final") {
-    throw bad_file_format_exception(line_number);
+  std::string_view contents() const {
+    if (data_ == MAP_FAILED) {
+      return std::string_view();
+    }
+
+    return std::string_view(static_cast<const char*>(data_), size_);
   }
+};
 
-  std::vector<std::string> tokens;
-  boost::trim(substr[1]); // remove leading and trailing whitespace
-  boost::split(tokens, substr[1], boost::is_any_of(" "));
+/**
+ * \brief Splits a text into lines, keeping track of the line number.
+ */
+class LineReader {
+ private:
 
-  std::vector<std::size_t> final_states;
+  std::string_view text_;
+  std::size_t line_number_ = 0;
 
-  for (std::size_t i = 0; i < tokens.size(); ++i) {
-    if (tokens[i] == "1") {
-      final_states.push_back(i);
+ public:
+
+  explicit LineReader(std::string_view text) : text_(text) {}
+
+  /**
+   * \brief Reads the next line, without the line terminator.
+   *
+   * \return false if the text has no more lines.
+   */
+  bool next(std::string_view& line) {
+    if (text_.empty()) {
+      return false;
     }
-  }
-  
-  return final_states;
-}
 
-std::vector<std::size_t> ExplicitStateDfa::read_behaviour(
-    std::istream& in,
-    std::size_t line_number) {
-  std::vector<std::string> substr = read_mona_line(in, line_number);
-  
-  if (substr[0] != "behaviour") {
-    throw bad_file_format_exception(line_number);
+    std::size_t end = text_.find('\n');
+    line = text_.substr(0, end);
+    text_.remove_prefix(end == std::string_view::npos ? text_.size() : end + 1);
+
+    if (!line.empty() && line.back() == '\r') {
+      line.remove_suffix(1);
+    }
+
+    ++line_number_;
+    return true;
   }
 
-  std::vector<std::string> tokens;
-  boost::trim(substr[1]); // remove leading and trailing whitespace
-  boost::split(tokens, substr[1], boost::is_any_of(" "));
+  std::size_t line_number() const {
+    return line_number_;
+  }
+};
 
-  std::vector<std::size_t> behaviour;
+bool is_blank(char c) {
+  return c == ' ' || c == '\t';
+}
 
-  try {
-    std::transform(tokens.begin(), tokens.end(), std::back_inserter(behaviour),
-		   [] (const std::string& token) { return std::stoi(token); });
+std::string_view trim(std::string_view text) {
+  while (!text.empty() && is_blank(text.front())) {
+    text.remove_prefix(1);
   }
-  catch (const std::exception& e) {
-    throw bad_file_format_exception(line_number);
+
+  while (!text.empty() && is_blank(text.back())) {
+    text.remove_suffix(1);
   }
-  
-  return behaviour;
-}
 
-std::vector<std::vector<int>> ExplicitStateDfa::read_node_table(
-    std::istream& in,
-    std::size_t line_number) {
-  std::string line;
-  std::getline(in, line);
+  return text;
+}
 
-  if (line != "bdd:") {
-    throw bad_file_format_exception(line_number);
+/**
+ * \brief Strips "key:" from the beginning of \a line.
+ *
+ * \return false if \a line does not start with "key:".
+ */
+bool strip_key(std::string_view& line, std::string_view key) {
+  if (line.size() <= key.size() || line.compare(0, key.size(), key) != 0 ||
+      line[key.size()] != ':') {
+    return false;
   }
 
-  std::vector<std::vector<int>> node_table;
-  
-  while (std::getline(in, line) && line != "end") {
-    ++line_number;
+  line.remove_prefix(key.size() + 1);
+  return true;
+}
+
+/**
+ * \brief Parses the whitespace-separated integers in \a text into \a numbers.
+ *
+ * \return false if \a text contains anything but integers.
+ */
+template <class Number>
+bool parse_numbers(std::string_view text, std::vector<Number>& numbers) {
+  const char* current = text.data();
+  const char* end = text.data() + text.size();
+
+  while (true) {
+    while (current != end && is_blank(*current)) {
+      ++current;
+    }
 
-    std::vector<std::string> tokens;
-    boost::trim(line); // remove leading and trailing whitespace
-    boost::split(tokens, line, boost::is_any_of(" "));
+    if (current == end) {
+      return true;
+    }
 
-    std::vector<int> node_triple;
-    std::transform(tokens.begin(), tokens.end(),
-		   std::back_inserter(node_triple),
-		   [] (const std::string& token) { return std::stoi(token); });
+    Number number;
+    auto [next, error] = std::from_chars(current, end, number);
 
-    if (node_triple.size() != 3) {
-      throw bad_file_format_exception(line_number);
+    if (error != std::errc() || (next != end && !is_blank(*next))) {
+      return false;
     }
 
-    node_table.push_back(std::move(node_triple));
+    numbers.push_back(number);
+    current = next;
   }
+}
+
+/**
+ * \brief A BDD node as stored by MONA, either in memory or in a DFA file.
+ */
+struct MonaNode {
+  bool leaf;
+  std::size_t variable;  // index in the variable names, if not a leaf
+  std::size_t low;       // value of the leaf, if a leaf
+  std::size_t high;
+};
 
-  if (line != "end") {
-    throw bad_file_format_exception(line_number + 1);
+/**
+ * \brief Translates a shared MONA BDD into ADDs.
+ *
+ * The nodes are visited with an explicit stack, so that deep BDDs do not
+ * overflow the call stack, and each node is translated once: the ADDs are
+ * memoized in an array indexed by node, which is shared by all the roots
+ * translated with the same builder.
+ */
+template <class NodeLoader>
+class MonaAddBuilder {
+ private:
+
+  std::shared_ptr<VarMgr> var_mgr_;
+  NodeLoader load_node_;
+  std::vector<CUDD::ADD> variables_;
+  std::vector<CUDD::ADD> adds_;
+  std::vector<char> built_;
+
+  bool is_built(std::size_t node) const {
+    return node < built_.size() && built_[node];
   }
 
-  return node_table;
-}
+  void store(std::size_t node, CUDD::ADD add) {
+    if (node >= adds_.size()) {
+      std::size_t size = std::max(node + 1, 2 * adds_.size());
+      adds_.resize(size);
+      built_.resize(size, false);
+    }
 
-CUDD::ADD ExplicitStateDfa::build_add(
-    std::size_t node_index,
-    const std::shared_ptr<VarMgr>& var_mgr,
-    const std::vector<std::string>& variable_names,
-    const std::vector<std::vector<int>>& node_table,
-    std::unordered_map<std::size_t, CUDD::ADD>& add_table) {
-  auto it = add_table.find(node_index);
-  
-  if (it != add_table.end()) {
-    return it->second;
+    adds_[node] = std::move(add);
+    built_[node] = true;
   }
-  else {
-    int name_index = node_table[node_index][0];
-    int low_child = node_table[node_index][1];
-    int high_child = node_table[node_index][2];
 
-    if (name_index == -1) {
-      add_table[node_index] = var_mgr->cudd_mgr()->constant(low_child);
+ public:
+
+  MonaAddBuilder(std::shared_ptr<VarMgr> var_mgr,
+                 const std::vector<std::string>& variable_names,
+                 std::size_t node_count_hint,
+                 NodeLoader load_node)
+    : var_mgr_(std::move(var_mgr)),
+      load_node_(std::move(load_node)),
+      adds_(node_count_hint),
+      built_(node_count_hint, false) {
+    variables_.reserve(variable_names.size());
+
+    for (const std::string& name : variable_names) {
+      variables_.push_back(var_mgr_->name_to_variable(name).Add());
     }
-    else {
-      std::string variable_name = variable_names[name_index];
-      CUDD::ADD root_node = var_mgr->name_to_variable(variable_name).Add();
-      CUDD::ADD low_node = build_add(low_child, var_mgr, variable_names,
-				     node_table, add_table);
-      CUDD::ADD high_node = build_add(high_child, var_mgr, variable_names,
-				      node_table, add_table);
-
-      add_table[node_index] = root_node.Ite(high_node, low_node);
+  }
+
+  CUDD::ADD build(std::size_t root) {
+    std::vector<std::size_t> stack = {root};
+
+    while (!stack.empty()) {
+      std::size_t node = stack.back();
+
+      if (is_built(node)) {
+        stack.pop_back();
+        continue;
+      }
+
+      MonaNode description = load_node_(node);
+
+      if (description.leaf) {
+        store(node, var_mgr_->cudd_mgr()->constant(description.low));
+        stack.pop_back();
+        continue;
+      }
+
+      bool children_built = true;
+
+      if (!is_built(description.high)) {
+        stack.push_back(description.high);
+        children_built = false;
+      }
+
+      if (!is_built(description.low)) {
+        stack.push_back(description.low);
+        children_built = false;
+      }
+
+      if (children_built) {
+        store(node, variables_[description.variable].Ite(
+            adds_[description.high], adds_[description.low]));
+        stack.pop_back();
+      }
     }
 
-    return add_table[node_index];
+    return adds_[root];
   }
+};
+
+template <class NodeLoader>
+MonaAddBuilder<NodeLoader> make_mona_add_builder(
+    std::shared_ptr<VarMgr> var_mgr,
+    const std::vector<std::string>& variable_names,
+    std::size_t node_count_hint,
+    NodeLoader load_node) {
+  return MonaAddBuilder<NodeLoader>(std::move(var_mgr), variable_names,
+                                    node_count_hint, std::move(load_node));
+}
+
+}
+
+ExplicitStateDfa::ExplicitStateDfa(std::shared_ptr<VarMgr> var_mgr)
+  : var_mgr_(std::move(var_mgr))
+{}
+
+std::runtime_error ExplicitStateDfa::bad_file_format_exception(
+    std::size_t line_number) {
+  return std::runtime_error("Incorrect format in line " +
+			    std::to_string(line_number) +
+			    " of the DFA file.");
 }
 
 std::string ExplicitStateDfa::ltlf_to_dfa_file(const std::string& ltlf_filename) {
@@ -216,6 +331,8 @@ std::string ExplicitStateDfa::safetyltl_to_dfa_file(const std::string& safetyltl
 
 ExplicitStateDfa ExplicitStateDfa::from_dfa_mona(std::shared_ptr<VarMgr> var_mgr,
                                                  const ExplicitStateDfaMona &explicit_dfa) {
+    ProfileSpan span("explicit DFA", "dfa2symbolic");
+
     std::size_t initial_state = explicit_dfa.get_initial_state();
 
     std::vector<std::string> variable_names = explicit_dfa.names;
@@ -229,12 +346,21 @@ ExplicitStateDfa ExplicitStateDfa::from_dfa_mona(std::shared_ptr<VarMgr> var_mgr
             final_states.push_back(curr_state);
         }
     }
-    std::unordered_map<std::size_t, CUDD::ADD> add_table;
+
+    bdd_manager* mgr = explicit_dfa.dfa_->bddm;
+    auto builder = make_mona_add_builder(
+        var_mgr, variable_names, 0,
+        [mgr] (std::size_t node) {
+            unsigned name_index, low_child, high_child;
+            LOAD_lri(&mgr->node_table[node], low_child, high_child, name_index);
+            return MonaNode{name_index == BDD_LEAF_INDEX, name_index,
+                            low_child, high_child};
+        });
     std::vector<CUDD::ADD> transition_function(state_count);
 
     for (std::size_t i = 0; i < state_count; ++i) {
-        transition_function[i] = build_add_from_dfa_mona(explicit_dfa.dfa_->q[i], var_mgr, variable_names,
-                                           explicit_dfa, add_table);
+        var_mgr->check_deadline();
+        transition_function[i] = builder.build(explicit_dfa.dfa_->q[i]);
     }
 
     ExplicitStateDfa dfa(std::move(var_mgr));
@@ -247,94 +373,149 @@ ExplicitStateDfa ExplicitStateDfa::from_dfa_mona(std::shared_ptr<VarMgr> var_mgr
 
 }
 
-CUDD::ADD ExplicitStateDfa::build_add_from_dfa_mona(unsigned node_index, const std::shared_ptr<VarMgr> &var_mgr,
-                                                    const std::vector<std::string> &variable_names,
-                                                    const ExplicitStateDfaMona& explicit_dfa,
-                                                    std::unordered_map<std::size_t, CUDD::ADD> &add_table) {
-    bdd_manager* mgr = explicit_dfa.dfa_->bddm;
-    auto it = add_table.find(node_index);
+ExplicitStateDfa ExplicitStateDfa::parse_mona_dfa(
+    std::shared_ptr<VarMgr> var_mgr,
+    std::string_view contents) {
+  LineReader reader(contents);
+  std::string_view line;
 
-    if (it != add_table.end()) {
-        return it->second;
+  auto next_line = [&reader, &line] () {
+    if (!reader.next(line)) {
+      throw bad_file_format_exception(reader.line_number() + 1);
     }
-    else {
-        unsigned name_index, low_child, high_child;
-        LOAD_lri(&mgr->node_table[node_index], low_child, high_child,
-                 name_index);
+  };
 
-        if (name_index == BDD_LEAF_INDEX) {
-            add_table[node_index] = var_mgr->cudd_mgr()->constant(low_child);
-        }
-        else {
-            std::string variable_name = variable_names[name_index];
-            CUDD::ADD root_node = var_mgr->name_to_variable(variable_name).Add();
-            CUDD::ADD low_node = build_add_from_dfa_mona(low_child, var_mgr, variable_names,
-                                           explicit_dfa, add_table);
-            CUDD::ADD high_node = build_add_from_dfa_mona(high_child, var_mgr, variable_names,
-                                            explicit_dfa, add_table);
-
-            add_table[node_index] = root_node.Ite(high_node, low_node);
-        }
+  next_line();
+  if (line != "MONA DFA") {
+    throw bad_file_format_exception(reader.line_number());
+  }
 
-        return add_table[node_index];
-    }
+  next_line(); // variable count; can be ignored
 
-}
+  next_line();
+  if (!strip_key(line, "variables")) {
+    throw bad_file_format_exception(reader.line_number());
+  }
 
-ExplicitStateDfa ExplicitStateDfa::read_from_file(
-    std::shared_ptr<VarMgr> var_mgr,
-    const std::string& filename) {
-  std::string explicit_state_dfa_filename = safetyltl_to_dfa_file(filename);
-  std::ifstream in(explicit_state_dfa_filename);
+  std::vector<std::string> variable_names;
+  std::string_view names = trim(line);
+  while (!names.empty()) {
+    std::size_t end = names.find(' ');
+    variable_names.emplace_back(names.substr(0, end));
+    names = trim(names.substr(std::min(end, names.size())));
+  }
+  var_mgr->create_named_variables(variable_names);
 
-  std::size_t line_number = 1;
-  std::string line;
-  std::getline(in, line);
+  next_line(); // variable orders; can be ignored
 
-  if (line != "MONA DFA") {
-    throw bad_file_format_exception(line_number);
+  next_line();
+  std::vector<std::size_t> counts;
+  if (!strip_key(line, "states") || !parse_numbers(line, counts) ||
+      counts.size() != 1) {
+    throw bad_file_format_exception(reader.line_number());
   }
+  std::size_t state_count = counts[0];
 
-  ++line_number;
-  std::getline(in, line); // variable count; can be ignored
-  
-  ++line_number;
-  std::vector<std::string> variable_names =
-    read_variable_names(in, line_number);
-  var_mgr->create_named_variables(variable_names);
-  
-  ++line_number;
-  std::getline(in, line); // variable orders; can be ignored
+  next_line(); // initial state; can be ignored (always 0)
+  std::size_t initial_state = 1; // state 0 is a dummy state, so ignore it
 
-  ++line_number;
-  std::size_t state_count = read_state_count(in, line_number);
+  // Node count; only used to size the node table
+  next_line();
+  counts.clear();
+  std::size_t node_count_hint = 0;
+  if (strip_key(line, "bdd nodes") && parse_numbers(line, counts) &&
+      counts.size() == 1) {
+    node_count_hint = counts[0];
+  }
 
-  ++line_number;
-  std::getline(in, line); // initial state; can be ignored (always 0)
-  std::size_t initial_state = 1; // state 0 is a dummy state, so ignore it
+  next_line();
+  std::vector<int> final_flags;
+  if (!strip_key(line, "final") || !parse_numbers(line, final_flags)) {
+    throw bad_file_format_exception(reader.line_number());
+  }
+
+  std::vector<std::size_t> final_states;
+  for (std::size_t i = 0; i < final_flags.size(); ++i) {
+    if (final_flags[i] == 1) {
+      final_states.push_back(i);
+    }
+  }
+
+  next_line();
+  std::size_t behaviour_line = reader.line_number();
+  std::vector<std::size_t> behaviour;
+  behaviour.reserve(state_count);
+  if (!strip_key(line, "behaviour") || !parse_numbers(line, behaviour) ||
+      behaviour.size() < state_count) {
+    throw bad_file_format_exception(behaviour_line);
+  }
+
+  next_line();
+  if (line != "bdd:") {
+    throw bad_file_format_exception(reader.line_number());
+  }
+
+  // Node i is stored in entries 3i (variable, -1 for leaves), 3i + 1 (low
+  // child or leaf value) and 3i + 2 (high child)
+  std::vector<int> node_table;
+  node_table.reserve(3 * node_count_hint);
+  std::size_t first_node_line = reader.line_number() + 1;
+
+  while (true) {
+    next_line();
 
-  ++line_number;
-  std::getline(in, line); // node count; can be ignored
+    if (line == "end") {
+      break;
+    }
 
-  ++line_number;
-  std::vector<std::size_t> final_states = read_final_states(in, line_number);
+    std::size_t previous_size = node_table.size();
+    if (!parse_numbers(line, node_table) ||
+        node_table.size() != previous_size + 3) {
+      throw bad_file_format_exception(reader.line_number());
+    }
+  }
 
-  ++line_number;
-  std::vector<std::size_t> behaviour = read_behaviour(in, line_number);
+  // Check the references once, so that the translation can trust them
+  std::size_t node_count = node_table.size() / 3;
+  for (std::size_t i = 0; i < node_count; ++i) {
+    int name_index = node_table[3 * i];
+    int low_child = node_table[3 * i + 1];
+    int high_child = node_table[3 * i + 2];
 
-  ++line_number;
-  std::vector<std::vector<int>> node_table = read_node_table(in, line_number);
+    bool well_formed = name_index == -1 ||
+      (name_index >= 0 && name_index < (int) variable_names.size() &&
+       low_child >= 0 && low_child < (int) node_count &&
+       high_child >= 0 && high_child < (int) node_count);
+
+    if (!well_formed) {
+      throw bad_file_format_exception(first_node_line + i);
+    }
+  }
+
+  for (std::size_t i = 0; i < state_count; ++i) {
+    if (behaviour[i] >= node_count) {
+      throw bad_file_format_exception(behaviour_line);
+    }
+  }
 
-  std::unordered_map<std::size_t, CUDD::ADD> add_table;
+  auto builder = make_mona_add_builder(
+      var_mgr, variable_names, node_count,
+      [&node_table] (std::size_t node) {
+        const int* triple = node_table.data() + 3 * node;
+        return MonaNode{triple[0] == -1, (std::size_t) triple[0],
+                        (std::size_t) triple[1], (std::size_t) triple[2]};
+      });
   std::vector<CUDD::ADD> transition_function(state_count);
 
   for (std::size_t i = 0; i < state_count; ++i) {
-    transition_function[i] = build_add(behaviour[i], var_mgr, variable_names,
-				       node_table, add_table);
+    var_mgr->check_deadline();
+    transition_function[i] = builder.build(behaviour[i]);
   }
 
   // Turn state 0 into a sink state
-  transition_function[0] = var_mgr->cudd_mgr()->constant(0);
+  if (state_count > 0) {
+    transition_function[0] = var_mgr->cudd_mgr()->constant(0);
+  }
 
   ExplicitStateDfa dfa(std::move(var_mgr));
   dfa.initial_state_ = initial_state;
@@ -345,9 +526,18 @@ ExplicitStateDfa ExplicitStateDfa::read_from_file(
   return dfa;
 }
 
+ExplicitStateDfa ExplicitStateDfa::read_from_file(
+    std::shared_ptr<VarMgr> var_mgr,
+    const std::string& filename) {
+  std::string explicit_state_dfa_filename = safetyltl_to_dfa_file(filename);
+  MappedFile file(explicit_state_dfa_filename);
+
+  return parse_mona_dfa(std::move(var_mgr), file.contents());
+}
+
 ExplicitStateDfa ExplicitStateDfa::complement_dfa(ExplicitStateDfa& d) {
     std::vector<size_t> final_states;
-    std::vector<size_t> current_final_states = d.final_states();
+    const std::vector<size_t>& current_final_states = d.final_states();
     for (size_t i = d.initial_state(); i < d.state_count(); i++){
         if(std::find(current_final_states.begin(), current_final_states.end(), i) == current_final_states.end()){
             final_states.push_back(i);
@@ -376,11 +566,11 @@ std::size_t ExplicitStateDfa::state_count() const {
   return state_count_;
 }
 
-std::vector<std::size_t> ExplicitStateDfa::final_states() const {
+const std::vector<std::size_t>& ExplicitStateDfa::final_states() const {
   return final_states_;
 }
 
-std::vector<CUDD::ADD> ExplicitStateDfa::transition_function() const {
+const std::vector<CUDD::ADD>& ExplicitStateDfa::transition_function() const {
   return transition_function_;
 }
 
@@ -3,11 +3,20 @@
 //
 
 #include "ExplicitStateDfaMona.h"
+#include "Profiler.h"
 
 #include "spotparser.h"
+#include "fol_translator.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
 #include <iostream>
 #include <istream>
+#include <mutex>
 #include <queue>
+#include <thread>
 #include <tuple>
 #include <unordered_map>
 #include <lydia/mona_ext/mona_ext_base.hpp>
@@ -19,9 +28,196 @@
 #include <lydia/utils/print.hpp>
 #include "lydia/logic/to_ldlf.hpp"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
 namespace Syft
 {
 
+    namespace {
+
+        // set by the executables, read by the synthesizers of concurrent
+        // sessions
+        std::atomic<TranslationBackend> default_backend{TranslationBackend::Lydia};
+
+        // MONA and Lydia keep global state, so formulas are translated, and
+        // DFAs multiplied, one at a time even when several threads synthesize
+        // concurrently
+        std::mutex mona_mutex;
+
+        std::runtime_error mona_error(const std::string& message) {
+            return std::runtime_error("Error: " + message + ": " + std::strerror(errno));
+        }
+
+        // A running "mona -xw" process, whose DFA is read from output
+        struct MonaProcess {
+            pid_t pid;
+            int output;
+        };
+
+        /*
+         * Starts "mona -xw" on the given program. The program is passed through
+         * an anonymous in-memory file and the DFA through a pipe, so nothing is
+         * written to disk. Both are close-on-exec, so that a MONA process
+         * only inherits its own program and pipe, as stdin and stdout, and not
+         * those of the other MONA processes or the sockets of the server.
+         */
+        MonaProcess start_mona(const std::string& program) {
+            int program_fd = memfd_create("mona_program", MFD_CLOEXEC);
+            if (program_fd == -1) {
+                throw mona_error("Could not create the MONA program");
+            }
+
+            std::size_t written = 0;
+            while (written < program.size()) {
+                ssize_t n = write(program_fd, program.data() + written, program.size() - written);
+                if (n == -1 && errno != EINTR) {
+                    close(program_fd);
+                    throw mona_error("Could not write the MONA program");
+                }
+                written += n == -1 ? 0 : n;
+            }
+            lseek(program_fd, 0, SEEK_SET);
+
+            int output[2];
+            if (pipe2(output, O_CLOEXEC) == -1) {
+                close(program_fd);
+                throw mona_error("Could not create a pipe to MONA");
+            }
+
+            pid_t pid = fork();
+            if (pid == -1) {
+                close(program_fd);
+                close(output[0]);
+                close(output[1]);
+                throw mona_error("Could not start MONA");
+            }
+
+            if (pid == 0) {
+                dup2(program_fd, STDIN_FILENO);
+                dup2(output[1], STDOUT_FILENO);
+                close(program_fd);
+                close(output[0]);
+                close(output[1]);
+                execlp("mona", "mona", "-xw", "/dev/stdin", (char*) nullptr);
+                _exit(127);
+            }
+
+            close(program_fd);
+            close(output[1]);
+
+            return {pid, output[0]};
+        }
+
+        /*
+         * Stops a MONA process whose DFA is not needed anymore.
+         */
+        void abandon_mona(const MonaProcess& process) {
+            // MONA may still be translating, or blocked writing the DFA, so it
+            // is killed rather than left to get SIGPIPE
+            close(process.output);
+            kill(process.pid, SIGKILL);
+            int status;
+            while (waitpid(process.pid, &status, 0) == -1 && errno == EINTR) {}
+        }
+
+        /*
+         * Imports the DFA printed by a MONA process and waits for it to exit.
+         * Returns the DFA and the names of its variables, in index order.
+         */
+        DFA* import_mona(const MonaProcess& process, std::vector<std::string>& mona_names) {
+            std::string output_path = "/dev/fd/" + std::to_string(process.output);
+            char** variables = nullptr;
+            int* orders = nullptr;
+            DFA* dfa = dfaImport(const_cast<char*>(output_path.c_str()), &variables, &orders);
+
+            // MONA gets SIGPIPE if the import stops early, e.g. on an error
+            close(process.output);
+            int status;
+            while (waitpid(process.pid, &status, 0) == -1 && errno == EINTR) {}
+
+            bool succeeded = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+
+            if (dfa != nullptr) {
+                for (std::size_t i = 0; i < mona_names.size(); ++i) {
+                    mona_names[i] = variables[i];
+                    mem_free(variables[i]);
+                }
+                mem_free(variables);
+                mem_free(orders);
+            }
+
+            if (!succeeded || dfa == nullptr) {
+                if (dfa != nullptr) {
+                    dfaFree(dfa);
+                }
+                throw std::runtime_error("Error: MONA could not translate the formula (exit status " +
+                                         std::to_string(WIFEXITED(status) ? WEXITSTATUS(status) : -1) + ").");
+            }
+
+            return dfa;
+        }
+
+        /*
+         * Runs "mona -xw" on the given program and imports the DFA it prints.
+         */
+        DFA* run_mona(const std::string& program, std::vector<std::string>& mona_names) {
+            return import_mona(start_mona(program), mona_names);
+        }
+
+        /*
+         * The minimized DFA of the output of MONA on the program of fol, with
+         * the names of the propositions.
+         */
+        ExplicitStateDfaMona dfa_of_mona_output(DFA* mona_dfa,
+                                                const FolProgram& fol,
+                                                const std::vector<std::string>& mona_names) {
+            // MONA names the variables in upper case, give them back their names
+            std::vector<std::string> names;
+            for (const std::string& mona_name : mona_names) {
+                auto it = std::find(fol.mona_names.begin(), fol.mona_names.end(), mona_name);
+                if (it == fol.mona_names.end()) {
+                    dfaFree(mona_dfa);
+                    throw std::runtime_error("Error: Unexpected variable " + mona_name + " in MONA's DFA.");
+                }
+                names.push_back(fol.propositions[it - fol.mona_names.begin()]);
+            }
+
+            // state 0 is a dummy initial state with a transition to state 1 on
+            // every letter (see ExplicitStateDfa::read_from_file); start from state
+            // 1 and let minimization drop state 0
+            mona_dfa->s = 1;
+            DFA* d = dfaMinimize(mona_dfa);
+            dfaFree(mona_dfa);
+
+            return ExplicitStateDfaMona(d, names);
+        }
+
+    }
+
+    std::string to_string(TranslationBackend backend) {
+        switch (backend) {
+            case TranslationBackend::Lydia:
+                return "lydia";
+            case TranslationBackend::Mona:
+                return "mona";
+        }
+
+        return "";
+    }
+
+    TranslationBackend translation_backend_from_string(const std::string& name) {
+        if (name == "lydia") {
+            return TranslationBackend::Lydia;
+        } else if (name == "mona") {
+            return TranslationBackend::Mona;
+        }
+
+        throw std::runtime_error("Error: Unknown translation backend " + name + ".");
+    }
+
     void ExplicitStateDfaMona::dfa_print()
     {
         std::cout << "Number of states " +
@@ -140,7 +336,98 @@ namespace Syft
         return res;
     }
 
+    void ExplicitStateDfaMona::set_translation_backend(TranslationBackend backend)
+    {
+        default_backend = backend;
+    }
+
+    TranslationBackend ExplicitStateDfaMona::translation_backend()
+    {
+        return default_backend;
+    }
+
     ExplicitStateDfaMona ExplicitStateDfaMona::dfa_of_formula(const std::string &formula)
+    {
+        return dfa_of_formula(formula, default_backend);
+    }
+
+    ExplicitStateDfaMona ExplicitStateDfaMona::dfa_of_formula(const std::string &formula,
+                                                              TranslationBackend backend)
+    {
+        std::lock_guard<std::mutex> lock(mona_mutex);
+        ProfileSpan span("translation", "ltlf2dfa");
+
+        switch (backend) {
+            case TranslationBackend::Mona:
+                return dfa_of_formula_mona(formula);
+            case TranslationBackend::Lydia:
+            default:
+                return dfa_of_formula_lydia(formula);
+        }
+    }
+
+    ExplicitStateDfaMona ExplicitStateDfaMona::dfa_of_formula_mona(const std::string &formula)
+    {
+        FolProgram fol = ltlf_to_fol(formula);
+
+        std::vector<std::string> mona_names(fol.mona_names.size());
+        DFA* mona_dfa = run_mona(fol.program, mona_names);
+
+        return dfa_of_mona_output(mona_dfa, fol, mona_names);
+    }
+
+    std::vector<ExplicitStateDfaMona> ExplicitStateDfaMona::dfas_of_formulas(const std::vector<std::string>& formulas)
+    {
+        std::vector<ExplicitStateDfaMona> dfas;
+        dfas.reserve(formulas.size());
+
+        TranslationBackend backend = default_backend;
+        if (backend != TranslationBackend::Mona) {
+            for (const std::string& formula : formulas) {
+                dfas.push_back(dfa_of_formula(formula, backend));
+            }
+            return dfas;
+        }
+
+        std::lock_guard<std::mutex> lock(mona_mutex);
+        ProfileSpan span("translation", "ltlf2dfa", "formulas", formulas.size());
+
+        std::size_t concurrency = std::max(1u, std::thread::hardware_concurrency());
+
+        // Starts the MONA processes of a batch of formulas, then imports their
+        // DFAs in order while the later ones are still running
+        for (std::size_t first = 0; first < formulas.size(); first += concurrency) {
+            std::size_t last = std::min(first + concurrency, formulas.size());
+
+            std::vector<FolProgram> programs;
+            std::vector<MonaProcess> processes;
+            std::size_t waited = 0; // processes already waited for
+
+            try {
+                for (std::size_t i = first; i < last; ++i) {
+                    programs.push_back(ltlf_to_fol(formulas[i]));
+                    processes.push_back(start_mona(programs.back().program));
+                }
+
+                for (std::size_t i = 0; i < processes.size(); ++i) {
+                    const FolProgram& fol = programs[i];
+                    std::vector<std::string> mona_names(fol.mona_names.size());
+                    waited = i + 1; // even if the import fails
+                    DFA* mona_dfa = import_mona(processes[i], mona_names);
+                    dfas.push_back(dfa_of_mona_output(mona_dfa, fol, mona_names));
+                }
+            } catch (...) {
+                for (std::size_t i = waited; i < processes.size(); ++i) {
+                    abandon_mona(processes[i]);
+                }
+                throw;
+            }
+        }
+
+        return dfas;
+    }
+
+    ExplicitStateDfaMona ExplicitStateDfaMona::dfa_of_formula_lydia(const std::string &formula)
     {
         whitemech::lydia::Logger logger("main");
         whitemech::lydia::Logger::level(whitemech::lydia::LogLevel::info);
@@ -186,9 +473,20 @@ namespace Syft
         return exp_dfa;
     }
 
+    ExplicitStateDfaMona ExplicitStateDfaMona::dfa_of_non_empty_traces()
+    {
+        // translated once per process, callers receive their own copy
+        static const ExplicitStateDfaMona no_empty_dfa =
+            dfa_of_formula("F(true)", TranslationBackend::Lydia);
+
+        return no_empty_dfa;
+    }
+
     // all the names may not be the same, needs a map for right indices
     ExplicitStateDfaMona ExplicitStateDfaMona::dfa_product(const std::vector<ExplicitStateDfaMona> &dfa_vector)
     {
+        std::lock_guard<std::mutex> lock(mona_mutex);
+
         // first record all variables, as they may not have the same alphabet
         std::unordered_map<std::string, int> name_to_index = {};
         std::vector<std::string> name_vector;
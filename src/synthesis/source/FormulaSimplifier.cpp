@@ -0,0 +1,761 @@
+#include "FormulaSimplifier.h"
+
+#include <algorithm>
+#include <cctype>
+#include <memory>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+#include "Profiler.h"
+
+namespace Syft {
+
+namespace {
+
+// True and False are the logical constants tt and ff, which hold (do not
+// hold) on every trace, including the empty one. PropositionalTrue and
+// PropositionalFalse are true and false, which are read as propositions: true
+// only holds where the trace has a position, so that F(true) is not tt
+enum class Kind {
+  True,
+  False,
+  PropositionalTrue,
+  PropositionalFalse,
+  Atom,
+  Not,
+  Next,
+  Globally,
+  Eventually,
+  Until,
+  Release,
+  WeakUntil,
+  And,
+  Or,
+  Implies,
+  Equiv
+};
+
+struct Node;
+using NodePtr = std::shared_ptr<const Node>;
+
+struct Node {
+  Kind kind;
+  std::string name;              // of an atom or a next operator, as written
+  std::vector<NodePtr> children;
+  std::string text;              // the formula, also used to compare nodes
+};
+
+bool is_binary(Kind kind) {
+  switch (kind) {
+    case Kind::Until:
+    case Kind::Release:
+    case Kind::WeakUntil:
+    case Kind::And:
+    case Kind::Or:
+    case Kind::Implies:
+    case Kind::Equiv:
+      return true;
+    default:
+      return false;
+  }
+}
+
+std::string operand(const NodePtr& node) {
+  return is_binary(node->kind) ? "(" + node->text + ")" : node->text;
+}
+
+std::string join(const std::vector<NodePtr>& operands,
+                 const std::string& separator) {
+  std::string text;
+
+  for (std::size_t i = 0; i < operands.size(); ++i) {
+    if (i > 0) text += separator;
+    text += operand(operands[i]);
+  }
+
+  return text;
+}
+
+NodePtr make_node(Kind kind, std::string name,
+                  std::vector<NodePtr> children) {
+  auto node = std::make_shared<Node>();
+  node->kind = kind;
+  node->name = std::move(name);
+  node->children = std::move(children);
+
+  const std::vector<NodePtr>& c = node->children;
+
+  switch (kind) {
+    case Kind::True:
+      node->text = "tt";
+      break;
+    case Kind::False:
+      node->text = "ff";
+      break;
+    case Kind::PropositionalTrue:
+      node->text = "true";
+      break;
+    case Kind::PropositionalFalse:
+      node->text = "false";
+      break;
+    case Kind::Atom:
+      node->text = node->name;
+      break;
+    case Kind::Not:
+      node->text = "!" + operand(c[0]);
+      break;
+    case Kind::Next:
+      node->text = node->name + "(" + c[0]->text + ")";
+      break;
+    case Kind::Globally:
+      node->text = "G(" + c[0]->text + ")";
+      break;
+    case Kind::Eventually:
+      node->text = "F(" + c[0]->text + ")";
+      break;
+    case Kind::Until:
+      node->text = join(c, " U ");
+      break;
+    case Kind::Release:
+      node->text = join(c, " R ");
+      break;
+    case Kind::WeakUntil:
+      node->text = join(c, " W ");
+      break;
+    case Kind::And:
+      node->text = join(c, " && ");
+      break;
+    case Kind::Or:
+      node->text = join(c, " || ");
+      break;
+    case Kind::Implies:
+      node->text = join(c, " -> ");
+      break;
+    case Kind::Equiv:
+      node->text = join(c, " <-> ");
+      break;
+  }
+
+  return node;
+}
+
+NodePtr make_constant(bool value) {
+  return make_node(value ? Kind::True : Kind::False, "", {});
+}
+
+std::size_t size(const NodePtr& node) {
+  std::size_t nodes = 1;
+
+  for (const NodePtr& child : node->children) {
+    nodes += size(child);
+  }
+
+  return nodes;
+}
+
+enum class TokenType {
+  LeftParen,
+  RightParen,
+  Equiv,
+  Implies,
+  Or,
+  And,
+  Not,
+  Next,
+  Globally,
+  Eventually,
+  Until,
+  Release,
+  WeakUntil,
+  True,
+  False,
+  PropositionalTrue,
+  PropositionalFalse,
+  Atom,
+  End
+};
+
+struct Token {
+  TokenType type;
+  std::string text;
+};
+
+// The tokens of the LTLf syntax of ltlf2fol, which Lydia's is a subset of
+std::vector<Token> tokenize(const std::string& formula) {
+  std::vector<Token> tokens;
+  std::size_t i = 0;
+
+  auto starts_with = [&](const char* prefix) {
+    return formula.compare(i, std::char_traits<char>::length(prefix),
+                           prefix) == 0;
+  };
+
+  while (i < formula.size()) {
+    char c = formula[i];
+
+    if (std::isspace(static_cast<unsigned char>(c))) {
+      ++i;
+    } else if (c == '(') {
+      tokens.push_back({TokenType::LeftParen, "("});
+      ++i;
+    } else if (c == ')') {
+      tokens.push_back({TokenType::RightParen, ")"});
+      ++i;
+    } else if (starts_with("<->")) {
+      tokens.push_back({TokenType::Equiv, "<->"});
+      i += 3;
+    } else if (starts_with("->")) {
+      tokens.push_back({TokenType::Implies, "->"});
+      i += 2;
+    } else if (starts_with("<>")) {
+      tokens.push_back({TokenType::Eventually, "F"});
+      i += 2;
+    } else if (starts_with("[]")) {
+      tokens.push_back({TokenType::Globally, "G"});
+      i += 2;
+    } else if (c == '&') {
+      tokens.push_back({TokenType::And, "&&"});
+      i += starts_with("&&") ? 2 : 1;
+    } else if (c == '|') {
+      tokens.push_back({TokenType::Or, "||"});
+      i += starts_with("||") ? 2 : 1;
+    } else if (c == '!' || c == '~') {
+      tokens.push_back({TokenType::Not, "!"});
+      ++i;
+    } else if (std::isalnum(static_cast<unsigned char>(c)) || c == '_') {
+      std::size_t start = i;
+      while (i < formula.size() &&
+             (std::isalnum(static_cast<unsigned char>(formula[i])) ||
+              formula[i] == '_')) {
+        ++i;
+      }
+      std::string word = formula.substr(start, i - start);
+
+      if (word == "X" && starts_with("[!]")) {
+        tokens.push_back({TokenType::Next, "X[!]"});
+        i += 3;
+      } else if (word == "X" || word == "N" || word == "WX") {
+        tokens.push_back({TokenType::Next, word});
+      } else if (word == "G") {
+        tokens.push_back({TokenType::Globally, word});
+      } else if (word == "F") {
+        tokens.push_back({TokenType::Eventually, word});
+      } else if (word == "U") {
+        tokens.push_back({TokenType::Until, word});
+      } else if (word == "R" || word == "V") {
+        tokens.push_back({TokenType::Release, word});
+      } else if (word == "W") {
+        tokens.push_back({TokenType::WeakUntil, word});
+      } else if (word == "tt") {
+        tokens.push_back({TokenType::True, word});
+      } else if (word == "ff") {
+        tokens.push_back({TokenType::False, word});
+      } else if (word == "true" || word == "True" || word == "TRUE" ||
+                 word == "1") {
+        tokens.push_back({TokenType::PropositionalTrue, word});
+      } else if (word == "false" || word == "False" || word == "FALSE" ||
+                 word == "0") {
+        tokens.push_back({TokenType::PropositionalFalse, word});
+      } else if (std::isdigit(static_cast<unsigned char>(word[0]))) {
+        throw std::invalid_argument("unexpected " + word);
+      } else {
+        tokens.push_back({TokenType::Atom, word});
+      }
+    } else {
+      throw std::invalid_argument(std::string("unexpected ") + c);
+    }
+  }
+
+  tokens.push_back({TokenType::End, ""});
+
+  return tokens;
+}
+
+// Recursive descent, with the precedences of Lydia: <-> (left), -> (right),
+// ||, &&, the binary temporal operators (right, not mixed) and the unary
+// operators
+class Parser {
+ private:
+
+  std::vector<Token> tokens_;
+  std::size_t position_ = 0;
+
+  const Token& peek() const {
+    return tokens_[position_];
+  }
+
+  bool accept(TokenType type) {
+    if (peek().type != type) return false;
+    ++position_;
+    return true;
+  }
+
+  NodePtr equivalence() {
+    NodePtr left = implication();
+    while (accept(TokenType::Equiv)) {
+      left = make_node(Kind::Equiv, "", {left, implication()});
+    }
+    return left;
+  }
+
+  NodePtr implication() {
+    NodePtr left = disjunction();
+    if (accept(TokenType::Implies)) {
+      return make_node(Kind::Implies, "", {left, implication()});
+    }
+    return left;
+  }
+
+  NodePtr disjunction() {
+    std::vector<NodePtr> operands = {conjunction()};
+    while (accept(TokenType::Or)) {
+      operands.push_back(conjunction());
+    }
+    return operands.size() == 1 ?
+      operands[0] : make_node(Kind::Or, "", std::move(operands));
+  }
+
+  NodePtr conjunction() {
+    std::vector<NodePtr> operands = {temporal()};
+    while (accept(TokenType::And)) {
+      operands.push_back(temporal());
+    }
+    return operands.size() == 1 ?
+      operands[0] : make_node(Kind::And, "", std::move(operands));
+  }
+
+  // The translators give U, R and W different precedences, so a chain that
+  // mixes them without parentheses is rejected rather than possibly read
+  // differently, and the formula is left untouched
+  NodePtr temporal() {
+    std::vector<NodePtr> operands = {unary()};
+    std::vector<Kind> operators;
+
+    while (true) {
+      if (accept(TokenType::Until)) {
+        operators.push_back(Kind::Until);
+      } else if (accept(TokenType::Release)) {
+        operators.push_back(Kind::Release);
+      } else if (accept(TokenType::WeakUntil)) {
+        operators.push_back(Kind::WeakUntil);
+      } else {
+        break;
+      }
+      operands.push_back(unary());
+    }
+
+    for (Kind kind : operators) {
+      if (kind != operators[0]) {
+        throw std::invalid_argument("mixed binary temporal operators");
+      }
+    }
+
+    NodePtr right = operands.back();
+    for (std::size_t i = operators.size(); i-- > 0;) {
+      right = make_node(operators[i], "", {operands[i], right});
+    }
+    return right;
+  }
+
+  NodePtr unary() {
+    Token token = peek();
+
+    if (accept(TokenType::Not)) {
+      return make_node(Kind::Not, "", {unary()});
+    } else if (accept(TokenType::Next)) {
+      return make_node(Kind::Next, token.text, {unary()});
+    } else if (accept(TokenType::Globally)) {
+      return make_node(Kind::Globally, "", {unary()});
+    } else if (accept(TokenType::Eventually)) {
+      return make_node(Kind::Eventually, "", {unary()});
+    } else if (accept(TokenType::True)) {
+      return make_constant(true);
+    } else if (accept(TokenType::False)) {
+      return make_constant(false);
+    } else if (accept(TokenType::PropositionalTrue)) {
+      return make_node(Kind::PropositionalTrue, "", {});
+    } else if (accept(TokenType::PropositionalFalse)) {
+      return make_node(Kind::PropositionalFalse, "", {});
+    } else if (accept(TokenType::Atom)) {
+      return make_node(Kind::Atom, token.text, {});
+    } else if (accept(TokenType::LeftParen)) {
+      NodePtr inner = equivalence();
+      if (!accept(TokenType::RightParen)) {
+        throw std::invalid_argument("missing )");
+      }
+      return inner;
+    }
+
+    throw std::invalid_argument("unexpected " + token.text);
+  }
+
+ public:
+
+  explicit Parser(std::vector<Token> tokens) : tokens_(std::move(tokens)) {}
+
+  NodePtr parse() {
+    NodePtr formula = equivalence();
+    if (peek().type != TokenType::End) {
+      throw std::invalid_argument("unexpected " + peek().text);
+    }
+    return formula;
+  }
+};
+
+// The smart constructors below take simplified operands, in which negations
+// only apply to atoms and next operators, and return simplified formulas
+
+NodePtr negation(const NodePtr& node);
+
+bool same(const NodePtr& lhs, const NodePtr& rhs) {
+  return lhs->text == rhs->text;
+}
+
+bool complementary(const NodePtr& lhs, const NodePtr& rhs) {
+  return (lhs->kind == Kind::Not && same(lhs->children[0], rhs)) ||
+         (rhs->kind == Kind::Not && same(rhs->children[0], lhs));
+}
+
+NodePtr globally(const NodePtr& operand) {
+  if (operand->kind == Kind::True || operand->kind == Kind::False ||
+      operand->kind == Kind::Globally) {
+    return operand;
+  }
+
+  return make_node(Kind::Globally, "", {operand});
+}
+
+NodePtr eventually(const NodePtr& operand) {
+  if (operand->kind == Kind::True || operand->kind == Kind::False ||
+      operand->kind == Kind::Eventually) {
+    return operand;
+  }
+
+  return make_node(Kind::Eventually, "", {operand});
+}
+
+// Conjunction (disjunction) of operands, flattened and without constants,
+// duplicates and complementary pairs, merging the operands under G (F)
+NodePtr junction(Kind kind, const std::vector<NodePtr>& operands) {
+  bool conjunction = kind == Kind::And;
+  Kind unit = conjunction ? Kind::True : Kind::False;
+  Kind zero = conjunction ? Kind::False : Kind::True;
+  Kind merged = conjunction ? Kind::Globally : Kind::Eventually;
+
+  std::vector<NodePtr> flattened;
+  for (const NodePtr& operand : operands) {
+    if (operand->kind == kind) {
+      flattened.insert(flattened.end(), operand->children.begin(),
+                       operand->children.end());
+    } else {
+      flattened.push_back(operand);
+    }
+  }
+
+  std::vector<NodePtr> result;
+  std::vector<NodePtr> merged_operands;
+  std::unordered_set<std::string> texts;
+
+  for (const NodePtr& operand : flattened) {
+    if (operand->kind == zero) {
+      return operand;
+    } else if (operand->kind == unit || !texts.insert(operand->text).second) {
+      continue;
+    } else if (operand->kind == merged) {
+      merged_operands.push_back(operand);
+    } else {
+      result.push_back(operand);
+    }
+  }
+
+  if (merged_operands.size() == 1) {
+    result.push_back(merged_operands[0]);
+  } else if (merged_operands.size() > 1) {
+    std::vector<NodePtr> inner;
+    for (const NodePtr& operand : merged_operands) {
+      inner.push_back(operand->children[0]);
+    }
+    NodePtr inner_junction = junction(kind, inner);
+    NodePtr merged_operand = conjunction ? globally(inner_junction) :
+                                           eventually(inner_junction);
+
+    if (merged_operand->kind == zero) {
+      return merged_operand;
+    } else if (merged_operand->kind != unit) {
+      result.push_back(merged_operand);
+    }
+  }
+
+  for (const NodePtr& operand : result) {
+    if (operand->kind == Kind::Not &&
+        texts.count(operand->children[0]->text) > 0) {
+      return make_constant(!conjunction);
+    }
+  }
+
+  if (result.empty()) {
+    return make_constant(conjunction);
+  } else if (result.size() == 1) {
+    return result[0];
+  }
+
+  return make_node(kind, "", std::move(result));
+}
+
+NodePtr until(const NodePtr& left, const NodePtr& right) {
+  if (right->kind == Kind::True || right->kind == Kind::False ||
+      left->kind == Kind::False || same(left, right)) {
+    return right;
+  } else if (left->kind == Kind::True) {
+    return eventually(right);
+  }
+
+  return make_node(Kind::Until, "", {left, right});
+}
+
+NodePtr release(const NodePtr& left, const NodePtr& right) {
+  if (right->kind == Kind::True || right->kind == Kind::False ||
+      left->kind == Kind::True || same(left, right)) {
+    return right;
+  } else if (left->kind == Kind::False) {
+    return globally(right);
+  }
+
+  return make_node(Kind::Release, "", {left, right});
+}
+
+NodePtr weak_until(const NodePtr& left, const NodePtr& right) {
+  if (right->kind == Kind::True || left->kind == Kind::True) {
+    return make_constant(true);
+  } else if (left->kind == Kind::False) {
+    return right;
+  } else if (right->kind == Kind::False) {
+    return globally(left);
+  } else if (same(left, right)) {
+    return left;
+  }
+
+  return make_node(Kind::WeakUntil, "", {left, right});
+}
+
+NodePtr equivalence(const NodePtr& left, const NodePtr& right) {
+  if (same(left, right)) {
+    return make_constant(true);
+  } else if (complementary(left, right)) {
+    return make_constant(false);
+  } else if (left->kind == Kind::True) {
+    return right;
+  } else if (right->kind == Kind::True) {
+    return left;
+  } else if (left->kind == Kind::False) {
+    return negation(right);
+  } else if (right->kind == Kind::False) {
+    return negation(left);
+  }
+
+  return make_node(Kind::Equiv, "", {left, right});
+}
+
+// Pushes the negation inwards; X is not dualized, since its dual depends on
+// whether the translator reads it as strong or weak
+NodePtr negation(const NodePtr& node) {
+  const std::vector<NodePtr>& c = node->children;
+
+  switch (node->kind) {
+    case Kind::True:
+      return make_constant(false);
+    case Kind::False:
+    case Kind::PropositionalFalse:
+      return make_constant(true);
+    case Kind::Not:
+      return c[0];
+    case Kind::Globally:
+      return eventually(negation(c[0]));
+    case Kind::Eventually:
+      return globally(negation(c[0]));
+    case Kind::Until:
+      return release(negation(c[0]), negation(c[1]));
+    case Kind::Release:
+      return until(negation(c[0]), negation(c[1]));
+    case Kind::WeakUntil:
+      // a W b = b R (a || b), so !(a W b) = !b U (!a && !b)
+      return until(negation(c[1]),
+                   junction(Kind::And, {negation(c[0]), negation(c[1])}));
+    case Kind::Equiv:
+      return equivalence(c[0], negation(c[1]));
+    case Kind::And:
+    case Kind::Or: {
+      std::vector<NodePtr> negated;
+      for (const NodePtr& operand : c) {
+        negated.push_back(negation(operand));
+      }
+      return junction(node->kind == Kind::And ? Kind::Or : Kind::And,
+                      negated);
+    }
+    default:
+      return make_node(Kind::Not, "", {node});
+  }
+}
+
+bool is_atom(const NodePtr& node) {
+  return node->kind == Kind::Atom;
+}
+
+// \a at_position tells that \a node only matters where the trace has a
+// position, e.g., as the operand of a next operator, so that true is tt there.
+// It carries over to the boolean connectives, which are evaluated at the same
+// position, but not to the other temporal operators
+NodePtr simplify(const NodePtr& node, bool at_position = false) {
+  const std::vector<NodePtr>& c = node->children;
+
+  switch (node->kind) {
+    case Kind::True:
+    case Kind::False:
+    case Kind::Atom:
+      return node;
+    case Kind::PropositionalTrue:
+      return at_position ? make_constant(true) : node;
+    case Kind::PropositionalFalse:
+      // holds nowhere, like ff
+      return make_constant(false);
+    case Kind::Not:
+      return negation(simplify(c[0], at_position));
+    case Kind::Next:
+      return make_node(Kind::Next, node->name, {simplify(c[0], true)});
+    case Kind::Globally:
+      return globally(simplify(c[0]));
+    case Kind::Eventually:
+      return eventually(simplify(c[0]));
+    case Kind::Until:
+      return until(simplify(c[0]), simplify(c[1]));
+    case Kind::Release:
+      return release(simplify(c[0]), simplify(c[1]));
+    case Kind::WeakUntil:
+      return weak_until(simplify(c[0]), simplify(c[1]));
+    case Kind::Implies:
+      return junction(Kind::Or, {negation(simplify(c[0], at_position)),
+                                 simplify(c[1], at_position)});
+    case Kind::Equiv:
+      return equivalence(simplify(c[0], at_position),
+                         simplify(c[1], at_position));
+    case Kind::And:
+    case Kind::Or: {
+      // A conjunction with an atom does not hold where there is no position,
+      // whatever its other operands are
+      bool operands_at_position = at_position ||
+        (node->kind == Kind::And && std::any_of(c.begin(), c.end(), is_atom));
+
+      std::vector<NodePtr> simplified;
+      for (const NodePtr& operand : c) {
+        simplified.push_back(simplify(operand, operands_at_position));
+      }
+      return junction(node->kind, simplified);
+    }
+  }
+
+  return node;
+}
+
+
+// Only reorders the operands of the commutative operators and drops repeated
+// ones, so that the result is equivalent to the formula on all traces
+NodePtr normalize(const NodePtr& node) {
+  std::vector<NodePtr> children;
+  for (const NodePtr& child : node->children) {
+    children.push_back(normalize(child));
+  }
+
+  if (node->kind == Kind::And || node->kind == Kind::Or) {
+    std::vector<NodePtr> flattened;
+    for (const NodePtr& child : children) {
+      if (child->kind == node->kind) {
+        flattened.insert(flattened.end(), child->children.begin(),
+                         child->children.end());
+      } else {
+        flattened.push_back(child);
+      }
+    }
+
+    std::sort(flattened.begin(), flattened.end(),
+              [](const NodePtr& lhs, const NodePtr& rhs) {
+                return lhs->text < rhs->text;
+              });
+    flattened.erase(std::unique(flattened.begin(), flattened.end(), same),
+                    flattened.end());
+
+    if (flattened.size() == 1) {
+      return flattened[0];
+    }
+
+    children = std::move(flattened);
+  } else if (node->kind == Kind::Equiv &&
+             children[1]->text < children[0]->text) {
+    std::swap(children[0], children[1]);
+  }
+
+  return make_node(node->kind, node->name, std::move(children));
+}
+}
+
+FormulaSimplification FormulaSimplifier::simplify(const std::string& formula) {
+  ProfileSpan span("formula simplification", "ltlf2dfa");
+
+  FormulaSimplification simplification;
+  simplification.formula = formula;
+
+  NodePtr parsed;
+  try {
+    parsed = Parser(tokenize(formula)).parse();
+  } catch (const std::invalid_argument&) {
+    return simplification;
+  }
+
+  NodePtr simplified = Syft::simplify(parsed);
+
+  simplification.formula = simplified->text;
+  simplification.original_size = size(parsed);
+  simplification.simplified_size = size(simplified);
+  simplification.parsed = true;
+
+  return simplification;
+}
+
+std::vector<std::string> FormulaSimplifier::top_level_conjuncts(
+    const std::string& formula) {
+  NodePtr parsed;
+  try {
+    parsed = Parser(tokenize(formula)).parse();
+  } catch (const std::invalid_argument&) {
+    return {formula};
+  }
+
+  std::vector<std::string> conjuncts;
+  std::unordered_set<std::string> texts;
+  std::vector<NodePtr> pending = {parsed};
+
+  while (!pending.empty()) {
+    NodePtr node = pending.back();
+    pending.pop_back();
+
+    if (node->kind == Kind::And) {
+      // reversed, so that the conjuncts come out in order
+      pending.insert(pending.end(), node->children.rbegin(),
+                     node->children.rend());
+    } else if (texts.insert(node->text).second) {
+      conjuncts.push_back(node->text);
+    }
+  }
+
+  return conjuncts;
+}
+
+std::string FormulaSimplifier::normal_form(const std::string& formula) {
+  try {
+    return normalize(Parser(tokenize(formula)).parse())->text;
+  } catch (const std::invalid_argument&) {
+    return formula;
+  }
+}
+
+}
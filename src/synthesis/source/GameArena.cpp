@@ -0,0 +1,94 @@
+#include "GameArena.h"
+
+namespace Syft {
+
+namespace {
+
+std::size_t quantification_index(Player starting_player,
+                                 Player protagonist_player,
+                                 bool cooperative) {
+  return (starting_player == Player::Agent ? 4 : 0) +
+         (protagonist_player == Player::Agent ? 2 : 0) +
+         (cooperative ? 1 : 0);
+}
+
+}
+
+GameArena::GameArena(SymbolicStateDfa dfa)
+  : dfa_(std::move(dfa)),
+    quantifications_(8) {
+  std::shared_ptr<VarMgr> var_mgr = dfa_.var_mgr();
+
+  initial_vector_ = var_mgr->make_eval_vector(dfa_.automaton_id(),
+                                              dfa_.initial_state());
+  transition_vector_ = var_mgr->make_compose_vector(
+      dfa_.automaton_id(), dfa_.transition_function());
+
+  input_cube_ = var_mgr->input_cube();
+  output_cube_ = var_mgr->output_cube();
+
+  // The independent variables are those that the moves of the protagonist
+  // don't depend on (the inputs if the agent plays first and is the
+  // protagonist, the outputs if the environment plays first and is the
+  // protagonist, none otherwise). In cooperative games, the opponent's
+  // variables are quantified existentially as well.
+  for (Player starting_player : {Player::Environment, Player::Agent}) {
+    const CUDD::BDD& first = starting_player == Player::Agent ? output_cube_ :
+                                                                input_cube_;
+    const CUDD::BDD& second = starting_player == Player::Agent ? input_cube_ :
+                                                                 output_cube_;
+
+    for (Player protagonist_player : {Player::Environment, Player::Agent}) {
+      GameQuantification& adversarial = quantifications_[quantification_index(
+          starting_player, protagonist_player, false)];
+      GameQuantification& cooperative = quantifications_[quantification_index(
+          starting_player, protagonist_player, true)];
+
+      if (starting_player == protagonist_player) {
+        adversarial.independent_variables = std::make_shared<Forall>(second);
+        adversarial.non_state_variables = std::make_shared<Exists>(first);
+        cooperative.independent_variables = std::make_shared<Exists>(second);
+        cooperative.non_state_variables = std::make_shared<Exists>(first);
+      } else {
+        adversarial.independent_variables =
+          std::make_shared<NoQuantification>();
+        adversarial.non_state_variables =
+          std::make_shared<ForallExists>(first, second);
+        cooperative.independent_variables =
+          std::make_shared<NoQuantification>();
+        cooperative.non_state_variables =
+          std::make_shared<ExistsExists>(first, second);
+      }
+    }
+  }
+}
+
+const SymbolicStateDfa& GameArena::dfa() const {
+  return dfa_;
+}
+
+const std::vector<int>& GameArena::initial_vector() const {
+  return initial_vector_;
+}
+
+const std::vector<CUDD::BDD>& GameArena::transition_vector() const {
+  return transition_vector_;
+}
+
+const CUDD::BDD& GameArena::input_cube() const {
+  return input_cube_;
+}
+
+const CUDD::BDD& GameArena::output_cube() const {
+  return output_cube_;
+}
+
+const GameQuantification& GameArena::quantification(Player starting_player,
+                                                    Player protagonist_player,
+                                                    bool cooperative) const {
+  return quantifications_[quantification_index(starting_player,
+                                               protagonist_player,
+                                               cooperative)];
+}
+
+}
@@ -0,0 +1,66 @@
+#include "HybridArenaBuilder.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "Profiler.h"
+
+namespace Syft {
+
+namespace {
+
+std::size_t explicit_state_budget = 0;
+
+}
+
+void HybridArenaBuilder::set_state_budget(std::size_t state_budget) {
+  explicit_state_budget = state_budget;
+}
+
+std::size_t HybridArenaBuilder::state_budget() {
+  return explicit_state_budget;
+}
+
+std::vector<ExplicitStateDfaMona> HybridArenaBuilder::multiply(
+    const std::vector<ExplicitStateDfaMona>& conjuncts,
+    std::size_t state_budget) {
+  ProfileSpan span("explicit products", "dfa2symbolic", "dfas",
+                   conjuncts.size());
+
+  // Pointers, since the assignment of ExplicitStateDfaMona copies the DFA
+  std::vector<std::unique_ptr<ExplicitStateDfaMona>> blocks;
+  for (const ExplicitStateDfaMona& conjunct : conjuncts) {
+    blocks.push_back(std::make_unique<ExplicitStateDfaMona>(conjunct));
+  }
+
+  auto fewer_states = [](const std::unique_ptr<ExplicitStateDfaMona>& lhs,
+                         const std::unique_ptr<ExplicitStateDfaMona>& rhs) {
+    return lhs->get_nb_states() < rhs->get_nb_states();
+  };
+
+  while (blocks.size() > 1) {
+    std::sort(blocks.begin(), blocks.end(), fewer_states);
+
+    std::size_t product_states =
+      std::size_t(blocks[0]->get_nb_states()) * blocks[1]->get_nb_states();
+
+    // If the two smallest blocks do not fit, no two blocks do
+    if (product_states > state_budget) {
+      break;
+    }
+
+    auto product = std::make_unique<ExplicitStateDfaMona>(
+        ExplicitStateDfaMona::dfa_product({*blocks[0], *blocks[1]}));
+    blocks.erase(blocks.begin(), blocks.begin() + 2);
+    blocks.push_back(std::move(product));
+  }
+
+  std::vector<ExplicitStateDfaMona> result;
+  for (const auto& block : blocks) {
+    result.push_back(*block);
+  }
+
+  return result;
+}
+
+}
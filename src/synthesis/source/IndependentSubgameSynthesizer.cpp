@@ -0,0 +1,226 @@
+#include "IndependentSubgameSynthesizer.h"
+
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "Profiler.h"
+
+namespace Syft {
+
+namespace {
+
+bool detected_subgames = false;
+
+}
+
+void IndependentSubgameSynthesizer::set_subgame_detection(
+    bool detect_subgames) {
+  detected_subgames = detect_subgames;
+}
+
+bool IndependentSubgameSynthesizer::subgame_detection() {
+  return detected_subgames;
+}
+
+IndependentSubgameSynthesizer::IndependentSubgameSynthesizer(
+    std::shared_ptr<const GameArena> arena,
+    std::vector<SymbolicStateDfa> components,
+    std::vector<CUDD::BDD> goal_terms,
+    CUDD::BDD guard,
+    Player starting_player,
+    Player protagonist_player)
+    : DfaGameSynthesizer(std::move(arena), starting_player, protagonist_player)
+    , guard_(guard) {
+  // A DFA that occurs more than once is a single factor of the product, see
+  // SymbolicStateDfa::product, whose goal is the disjunction of its goals
+  for (std::size_t i = 0; i < components.size(); ++i) {
+    std::size_t j = 0;
+    while (j < components_.size() &&
+           components_[j].automaton_id() != components[i].automaton_id()) {
+      ++j;
+    }
+
+    if (j < components_.size()) {
+      goal_terms_[j] |= goal_terms[i];
+    } else {
+      components_.push_back(components[i]);
+      goal_terms_.push_back(goal_terms[i]);
+    }
+  }
+
+  find_clusters();
+}
+
+void IndependentSubgameSynthesizer::find_clusters() {
+  ProfileSpan span("subgame detection", "games", "dfas", components_.size());
+
+  // Union-find over the DFAs that read some input or output variable, merging
+  // those that read a common one
+  std::vector<std::size_t> parent(components_.size());
+  std::iota(parent.begin(), parent.end(), 0);
+
+  auto find = [&parent](std::size_t i) {
+    while (parent[i] != i) {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  };
+
+  std::unordered_map<unsigned int, std::size_t> reader;  // by variable index
+  std::vector<bool> shared(components_.size(), true);
+
+  for (std::size_t i = 0; i < components_.size(); ++i) {
+    CUDD::BDD support = var_mgr_->cudd_mgr()->bddOne();
+    for (const CUDD::BDD& bit : components_[i].transition_function()) {
+      support &= bit.Support();
+    }
+
+    for (unsigned int index : support.SupportIndices()) {
+      VariableRole role = var_mgr_->variable_info(index).role;
+
+      if (role != VariableRole::Input && role != VariableRole::Output) {
+        continue;
+      }
+
+      shared[i] = false;
+
+      auto it = reader.find(index);
+      if (it == reader.end()) {
+        reader.emplace(index, i);
+      } else {
+        parent[find(i)] = find(it->second);
+      }
+    }
+  }
+
+  std::unordered_map<std::size_t, std::size_t> cluster_of_root;
+
+  for (std::size_t i = 0; i < components_.size(); ++i) {
+    if (shared[i]) {
+      shared_components_.push_back(i);
+      continue;
+    }
+
+    auto it = cluster_of_root.emplace(find(i), clusters_.size()).first;
+    if (it->second == clusters_.size()) {
+      clusters_.emplace_back();
+    }
+    clusters_[it->second].push_back(i);
+  }
+
+  if (clusters_.size() < 2 || !depends_only_on(guard_, shared_components_)) {
+    return;
+  }
+
+  for (std::size_t i = 0; i < components_.size(); ++i) {
+    if (!depends_only_on(goal_terms_[i], {i})) {
+      return;
+    }
+  }
+
+  decomposable_ = true;
+}
+
+bool IndependentSubgameSynthesizer::depends_only_on(
+    const CUDD::BDD& bdd, const std::vector<std::size_t>& components) const {
+  std::unordered_set<unsigned int> state_variables;
+
+  for (std::size_t i : components) {
+    std::size_t automaton_id = components_[i].automaton_id();
+
+    for (std::size_t b = 0; b < var_mgr_->state_variable_count(automaton_id);
+         ++b) {
+      state_variables.insert(
+          var_mgr_->state_variable(automaton_id, b).NodeReadIndex());
+    }
+  }
+
+  for (unsigned int index : bdd.SupportIndices()) {
+    if (state_variables.count(index) == 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool IndependentSubgameSynthesizer::decomposable() const {
+  return decomposable_;
+}
+
+std::size_t IndependentSubgameSynthesizer::subgame_count() const {
+  return decomposable_ ? clusters_.size() : 1;
+}
+
+SynthesisResult IndependentSubgameSynthesizer::run() const {
+  ProfileSpan span("independent subgames", "games", "subgames",
+                   clusters_.size());
+
+  if (!decomposable_) {
+    throw std::runtime_error("Error: The game has no independent subgames.");
+  }
+
+  CUDD::BDD winning_states = var_mgr_->cudd_mgr()->bddZero();
+  CUDD::BDD winning_moves = var_mgr_->cudd_mgr()->bddZero();
+  bool realizability = false;
+
+  for (const std::vector<std::size_t>& cluster : clusters_) {
+    var_mgr_->check_deadline();
+
+    std::vector<std::size_t> members = cluster;
+    members.insert(members.end(), shared_components_.begin(),
+                   shared_components_.end());
+
+    CUDD::BDD goal_states = var_mgr_->cudd_mgr()->bddZero();
+    std::vector<SymbolicStateDfa> dfas;
+    for (std::size_t i : members) {
+      goal_states |= goal_terms_[i];
+      dfas.push_back(components_[i]);
+    }
+    goal_states &= guard_;
+
+    if (goal_states.IsZero()) {
+      continue;
+    }
+
+    GameArena subgame(dfas.size() == 1 ? dfas[0] :
+                                         SymbolicStateDfa::product(dfas));
+
+    ReachabilityArena arena;
+    arena.goal_states = goal_states;
+    arena.state_space = subgame.dfa().valid_states();
+    arena.transition_vector = subgame.transition_vector();
+    arena.initial_vector = subgame.initial_vector();
+    arena.preimage_quantifiers = quantify_independent_variables_->quantifiers();
+    arena.projection_quantifiers =
+      quantify_non_state_variables_->quantifiers();
+
+    ReachabilityFixpoint fixpoint = solve_reachability(*var_mgr_, arena);
+
+    // The moves of a subgame are only played outside the winning states of
+    // the previous ones, so that the play keeps progressing in a single one
+    winning_moves |= fixpoint.winning_moves & !winning_states;
+    winning_states |= fixpoint.winning_states;
+
+    if (fixpoint.includes_initial_state) {
+      realizability = true;
+      break;
+    }
+  }
+
+  SynthesisResult result;
+  result.realizability = realizability;
+  result.winning_states = winning_states;
+  std::unordered_map<int, CUDD::BDD> strategy =
+    synthesize_strategy(winning_moves);
+
+  result.transducer = std::make_unique<Transducer>(
+        var_mgr_, arena_->initial_vector(), strategy, spec_.transition_function(),
+        spec_.automaton_id(), starting_player_, protagonist_player_);
+  return result;
+}
+
+}
@@ -0,0 +1,130 @@
+#include "Profiler.h"
+
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include <unistd.h>
+
+namespace Syft {
+
+namespace {
+
+struct SpanRecord {
+  const char* name;
+  const char* category;
+  const char* arg_name;
+  long arg_value;
+  int thread;
+  long long start;     // microseconds since the first span of the process
+  long long duration;  // microseconds
+};
+
+std::mutex spans_mutex;
+std::vector<SpanRecord> spans;
+
+std::chrono::steady_clock::time_point trace_epoch() {
+  static const std::chrono::steady_clock::time_point epoch =
+    std::chrono::steady_clock::now();
+  return epoch;
+}
+
+// small sequential ids, which trace viewers display more readably than the
+// ids of the operating system
+int thread_index() {
+  static std::atomic<int> next_index{1};
+  thread_local const int index = next_index++;
+  return index;
+}
+
+long long microseconds(std::chrono::steady_clock::duration duration) {
+  return std::chrono::duration_cast<std::chrono::microseconds>(duration)
+    .count();
+}
+
+void write_json_string(std::ostream& out, const char* text) {
+  out << '"';
+  for (const char* c = text; *c; ++c) {
+    if (*c == '"' || *c == '\\') {
+      out << '\\';
+    }
+    out << *c;
+  }
+  out << '"';
+}
+
+}
+
+void Profiler::enable() {
+  trace_epoch();
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+void Profiler::disable() {
+  enabled_.store(false, std::memory_order_relaxed);
+}
+
+void Profiler::record(const char* name, const char* category,
+                      const char* arg_name, long arg_value,
+                      std::chrono::steady_clock::time_point start,
+                      std::chrono::steady_clock::time_point end) {
+  SpanRecord span{name, category, arg_name, arg_value, thread_index(),
+                  microseconds(start - trace_epoch()),
+                  microseconds(end - start)};
+
+  std::lock_guard<std::mutex> lock(spans_mutex);
+  spans.push_back(span);
+}
+
+void Profiler::clear() {
+  std::lock_guard<std::mutex> lock(spans_mutex);
+  spans.clear();
+}
+
+std::size_t Profiler::span_count() {
+  std::lock_guard<std::mutex> lock(spans_mutex);
+  return spans.size();
+}
+
+void Profiler::write_chrome_trace(std::ostream& out) {
+  std::lock_guard<std::mutex> lock(spans_mutex);
+  long pid = getpid();
+
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+  for (std::size_t i = 0; i < spans.size(); ++i) {
+    const SpanRecord& span = spans[i];
+
+    out << (i == 0 ? "\n" : ",\n");
+    out << "{\"name\":";
+    write_json_string(out, span.name);
+    out << ",\"cat\":";
+    write_json_string(out, span.category);
+    out << ",\"ph\":\"X\",\"ts\":" << span.start << ",\"dur\":"
+        << span.duration << ",\"pid\":" << pid << ",\"tid\":" << span.thread;
+
+    if (span.arg_name) {
+      out << ",\"args\":{";
+      write_json_string(out, span.arg_name);
+      out << ":" << span.arg_value << "}";
+    }
+
+    out << "}";
+  }
+
+  out << "\n]}" << std::endl;
+}
+
+void Profiler::write_chrome_trace(const std::string& filename) {
+  std::ofstream out(filename);
+
+  if (!out) {
+    throw std::runtime_error("Error: Cannot write trace file " + filename +
+                             ".");
+  }
+
+  write_chrome_trace(out);
+}
+
+}
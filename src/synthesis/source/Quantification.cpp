@@ -8,6 +8,10 @@ CUDD::BDD NoQuantification::apply(const CUDD::BDD& bdd) const {
   return bdd;
 }
 
+std::vector<Quantifier> NoQuantification::quantifiers() const {
+  return {};
+}
+
 Forall::Forall(CUDD::BDD universal_variables)
   : universal_variables_(std::move(universal_variables))
 {}
@@ -16,6 +20,10 @@ CUDD::BDD Forall::apply(const CUDD::BDD& bdd) const {
   return bdd.UnivAbstract(universal_variables_);
 }
 
+std::vector<Quantifier> Forall::quantifiers() const {
+  return {{true, universal_variables_}};
+}
+
 Exists::Exists(CUDD::BDD existential_variables)
   : existential_variables_(std::move(existential_variables))
 {}
@@ -24,6 +32,10 @@ CUDD::BDD Exists::apply(const CUDD::BDD& bdd) const {
   return bdd.ExistAbstract(existential_variables_);
 }
 
+std::vector<Quantifier> Exists::quantifiers() const {
+  return {{false, existential_variables_}};
+}
+
 ForallExists::ForallExists(CUDD::BDD universal_variables,
 			   CUDD::BDD existential_variables)
   : forall_(std::move(universal_variables))
@@ -34,6 +46,12 @@ CUDD::BDD ForallExists::apply(const CUDD::BDD& bdd) const {
   return forall_.apply(exists_.apply(bdd));
 }
 
+std::vector<Quantifier> ForallExists::quantifiers() const {
+  std::vector<Quantifier> quantifiers = exists_.quantifiers();
+  quantifiers.push_back(forall_.quantifiers().front());
+  return quantifiers;
+}
+
 // IMPLEMENTATION OF ABSTRACTION FOR DOUBLE EXISTENTIAL QUANTIFICATION
 ExistsExists::ExistsExists(CUDD::BDD existential_variables_a,
                             CUDD::BDD existential_variables_b):
@@ -43,6 +61,12 @@ ExistsExists::ExistsExists(CUDD::BDD existential_variables_a,
 CUDD::BDD ExistsExists::apply(const CUDD::BDD &bdd) const {
   return exists_a_.apply(exists_b_.apply(bdd));
 }
+
+std::vector<Quantifier> ExistsExists::quantifiers() const {
+  std::vector<Quantifier> quantifiers = exists_b_.quantifiers();
+  quantifiers.push_back(exists_a_.quantifiers().front());
+  return quantifiers;
+}
 // END
 
 ExistsForall::ExistsForall(CUDD::BDD existential_variables,
@@ -55,4 +79,10 @@ CUDD::BDD ExistsForall::apply(const CUDD::BDD& bdd) const {
     return exists_.apply(forall_.apply(bdd));
 }
 
+std::vector<Quantifier> ExistsForall::quantifiers() const {
+    std::vector<Quantifier> quantifiers = forall_.quantifiers();
+    quantifiers.push_back(exists_.quantifiers().front());
+    return quantifiers;
+}
+
 }
@@ -1,4 +1,9 @@
 #include"RefiningEnvironmentsChainSynthesizer.h"
+#include"ConjunctiveDfa.h"
+#include"Profiler.h"
+
+#include<numeric>
+#include<optional>
 
 namespace Syft {
 
@@ -8,51 +13,69 @@ namespace Syft {
                 std::vector<std::string> refinements,
                 std::string env_base,
                 Syft::InputOutputPartition partition,
-                Syft::Player starting_player
+                Syft::Player starting_player,
+                std::shared_ptr<EnvironmentCache> environment_cache
             ): var_mgr_(var_mgr),
             ltlf_goal_(ltlf_goal),
             refinements_(refinements),
             env_base_(env_base),
             partition_(partition),
-            starting_player_(starting_player) 
+            starting_player_(starting_player),
+            environment_cache_(environment_cache ? environment_cache : std::make_shared<EnvironmentCache>(var_mgr))
         {
+        if (environment_cache_->var_mgr() != var_mgr_) {
+            throw std::runtime_error("Error: The environment cache belongs to another variable manager.");
+        }
+
+        Syft::Stopwatch construction;
+        construction.start();
+
+        try {
+            construct_arenas();
+        } catch (const DeadlineExceeded& e) {
+            timed_out_ = true;
+            run_times_.push_back(construction.stop().count() / 1000.0 -
+                std::accumulate(run_times_.begin(), run_times_.end(), 0.0)); // interrupted phase
+            std::cout << std::endl << "[conj-MtSyft] timeout while constructing the game arenas (" << e.what() << ")" << std::endl;
+        }
+    }
+
+    void RefiningEnvironmentsChainSynthesizer::construct_arenas() {
+            // translations and symbolizations saved by the memoized DFAs
+            std::size_t memo_hits_before = ConjunctiveDfa::memo_hits();
+            std::size_t dfa_hits_before = environment_cache_->dfa_hits();
+
             Syft::Stopwatch ltlf2dfas;
             ltlf2dfas.start();
 
             Syft::Stopwatch goal2dfa;
             goal2dfa.start();
 
-            ExplicitStateDfaMona mona_goal_dfa =
-                ExplicitStateDfaMona::dfa_of_formula(ltlf_goal_);
+            ConjunctiveDfa mona_goal_dfa =
+                ConjunctiveDfa::of_formula(ltlf_goal_);
 
             double t_goal2dfa = goal2dfa.stop().count() / 1000.0;
 
             std::vector<double> t_refinement2dfas;
 
-            std::vector<ExplicitStateDfaMona> mona_refinements_dfas;
+            std::vector<std::optional<ConjunctiveDfa>> mona_refinements_dfas; // empty if the symbolic DFA is already cached
             for (const auto& refinement: refinements_) {
+                var_mgr_->check_deadline();
                 Syft::Stopwatch refinement2dfa;
                 refinement2dfa.start();
-                mona_refinements_dfas.push_back(ExplicitStateDfaMona::dfa_of_formula(refinement)); // E'_1, E'_2, ..., E'_{n-1}
+                if (environment_cache_->reuse_dfa(refinement)) mona_refinements_dfas.emplace_back();
+                else mona_refinements_dfas.push_back(ConjunctiveDfa::of_formula(refinement)); // E'_1, E'_2, ..., E'_{n-1}
                 t_refinement2dfas.push_back(refinement2dfa.stop().count() / 1000.0);
             }
 
             Syft::Stopwatch base2dfa;
             base2dfa.start();
 
-            ExplicitStateDfaMona mona_base_dfa =
-                ExplicitStateDfaMona::dfa_of_formula(env_base); // E_{n}
+            std::optional<ConjunctiveDfa> mona_base_dfa; // E_{n}, empty if the symbolic DFA is already cached
+            if (!environment_cache_->reuse_dfa(env_base_)) mona_base_dfa = ConjunctiveDfa::of_formula(env_base_);
 
             double t_base2dfa = base2dfa.stop().count() / 1000.0;
 
-            Syft::Stopwatch tau2dfa;
-            tau2dfa.start();
-
-            ExplicitStateDfaMona mona_no_empty_dfa =
-                ExplicitStateDfaMona::dfa_of_formula("F(true)");
-
-            double t_tau2dfa = tau2dfa.stop().count() / 1000.0;
-
             // debug
             // mona_goal_dfa.dfa_print();
             // std::cout << std::endl;
@@ -70,7 +93,6 @@ namespace Syft {
                 std::cout << "\t[conj-MtSyft] refinement " << i+1 << " to DFA in " << t_refinement2dfas[i] << " s" << std::endl;
             }
             std::cout << "\t[conj-MtSyft] env base to DFA in " << t_base2dfa << " s" << std::endl;
-            std::cout << "\t[conj-MtSyft] tautoloty to DFA in " << t_tau2dfa << " s" << std::endl;
 
             std::cout << "[conj-MtSyft] preprocessing...";
             Syft::Stopwatch pre;
@@ -89,11 +111,16 @@ namespace Syft {
             
             // Rewrites the preprocessing phase to not use the SPOT parser
             // which does not interact well with Lydia (does not support Lydia's X[!])
-            var_mgr_->create_named_variables(mona_goal_dfa.names);
-            for (const auto& refinement_dfa: mona_refinements_dfas) var_mgr_->create_named_variables(refinement_dfa.names);
+            var_mgr_->create_named_variables(mona_goal_dfa.names());
+            for (const auto& refinement_dfa: mona_refinements_dfas) if (refinement_dfa) var_mgr_->create_named_variables(refinement_dfa->names());
+            if (mona_base_dfa) var_mgr_->create_named_variables(mona_base_dfa->names());
 
-            var_mgr_->partition_variables(partition.input_variables,
-                                        partition.output_variables);
+            // also the variables that no formula mentions, e.g., after the
+            // simplification of the formulas
+            var_mgr_->create_named_variables(partition_.input_variables);
+            var_mgr_->create_named_variables(partition_.output_variables);
+            var_mgr_->partition_variables(partition_.input_variables,
+                                        partition_.output_variables);
 
             double t_pre = pre.stop().count() / 1000.0;
             std::cout <<  "DONE (" << t_pre << " s)" << std::endl;
@@ -105,28 +132,29 @@ namespace Syft {
             Syft::Stopwatch goal2sym;
             goal2sym.start();
 
-            ExplicitStateDfa goal_dfa = ExplicitStateDfa::from_dfa_mona(var_mgr_, mona_goal_dfa);
-            symbolic_dfas_.push_back(SymbolicStateDfa::from_explicit(std::move(goal_dfa)));
+            symbolic_dfas_.push_back(mona_goal_dfa.to_symbolic(*environment_cache_));
 
             double t_goal2sym = goal2sym.stop().count() / 1000.0;
 
             std::vector<double> t_refinement2sym;
 
-            std::vector<ExplicitStateDfa> refinement_dfas;
-
             for (int i = 0; i < mona_refinements_dfas.size(); ++i) {
                 Syft::Stopwatch refinement2sym;
                 refinement2sym.start();
-                refinement_dfas.push_back(ExplicitStateDfa::from_dfa_mona(var_mgr_, mona_refinements_dfas[i]));
-                symbolic_dfas_.push_back(SymbolicStateDfa::from_explicit(std::move(refinement_dfas[i])));
+                if (mona_refinements_dfas[i]) {
+                    environment_cache_->insert_dfa(refinements_[i], mona_refinements_dfas[i]->to_symbolic(*environment_cache_));
+                }
+                symbolic_dfas_.push_back(*environment_cache_->find_dfa(refinements_[i]));
                 t_refinement2sym.push_back(refinement2sym.stop().count() / 1000.0);
             }
 
             Syft::Stopwatch base2sym;
             base2sym.start();
 
-            ExplicitStateDfa base_dfa = ExplicitStateDfa::from_dfa_mona(var_mgr_, mona_base_dfa);
-            symbolic_dfas_.push_back(SymbolicStateDfa::from_explicit(std::move(base_dfa)));
+            if (mona_base_dfa) {
+                environment_cache_->insert_dfa(env_base_, mona_base_dfa->to_symbolic(*environment_cache_));
+            }
+            symbolic_dfas_.push_back(*environment_cache_->find_dfa(env_base_));
 
             double t_base2sym = base2sym.stop().count() / 1000.0;
 
@@ -137,8 +165,8 @@ namespace Syft {
             Syft::Stopwatch tau2sym;
             tau2sym.start();
 
-            ExplicitStateDfa no_empty_dfa = ExplicitStateDfa::from_dfa_mona(var_mgr_, mona_no_empty_dfa);
-            symbolic_dfas_.push_back(SymbolicStateDfa::from_explicit(std::move(no_empty_dfa)));
+            // shared with the arenas of the environment restrictions
+            symbolic_dfas_.push_back(environment_cache_->non_empty_traces_dfa());
 
             double t_tau2sym = tau2sym.stop().count() / 1000.0;
 
@@ -162,101 +190,165 @@ namespace Syft {
                 std::cout << "\t[conj-MtSyft] env refinement "  << i+1 << " DFA to symbolic in " << t_refinement2sym[i] << " s" << std::endl; 
             }
             std::cout << "\t[conj-MtSyft] env base DFA to symbolic in " << t_base2sym << " s" << std::endl;
+            std::cout << "\t[conj-MtSyft] DFAs reused: " << ConjunctiveDfa::memo_hits() - memo_hits_before << " translations, " << environment_cache_->dfa_hits() - dfa_hits_before << " symbolizations" << std::endl;
             std::cout << "\t[conj-MtSyft] symbolic arena construction in " << t_sym2arena << " s" << std::endl;
         }
 
     ChainedStrategies RefiningEnvironmentsChainSynthesizer::run() {
+        ChainedStrategies result;
 
-        std::cout << "[conj-MtSyft] constructing and solving games...";
+        if (timed_out_) {
+            result.timed_out = true;
+            return result;
+        }
 
-        ChainedStrategies result;
+        Syft::Stopwatch games;
+        games.start();
+        double construction_time = std::accumulate(run_times_.begin(), run_times_.end(), 0.0);
+
+        try {
+            solve_games(result);
+        } catch (const DeadlineExceeded& e) {
+            timed_out_ = true;
+            result.timed_out = true;
+            run_times_.push_back(construction_time + games.stop().count() / 1000.0 -
+                std::accumulate(run_times_.begin(), run_times_.end(), 0.0)); // interrupted phase
+            std::cout << std::endl << "[conj-MtSyft] timeout while solving the games (" << e.what() << ")" << std::endl;
+        }
+
+        return result;
+    }
+
+    void RefiningEnvironmentsChainSynthesizer::set_tier_solving(TierSolving tier_solving) {
+        tier_solving_ = tier_solving;
+    }
+
+    void RefiningEnvironmentsChainSynthesizer::set_arena_minimization(bool minimize_arenas) {
+        minimize_arenas_ = minimize_arenas;
+    }
 
+    void RefiningEnvironmentsChainSynthesizer::solve_games(ChainedStrategies& result) {
+
+        ProfileSpan span("solving games", "tiers");
+
+        // env final states of each tier, from E_1 (all refinements) to E_n (base only)
+        int tiers = symbolic_dfas_.size() - 2;
+        std::vector<CUDD::BDD> env_final_states(tiers);
+        CUDD::BDD conjunction = var_mgr_->cudd_mgr()->bddOne();
+        for (int i = symbolic_dfas_.size() - 2; i >= 1; --i) {
+            conjunction = conjunction * symbolic_dfas_[i].final_states();
+            env_final_states[i - 1] = conjunction;
+        }
+
+        // minimization is counted with the adversarial games
         Syft::Stopwatch adv_games;
         adv_games.start();
 
+        if (minimize_arenas_) {
+            std::cout << "[conj-MtSyft] minimizing arena...";
+            Syft::Stopwatch minimization;
+            minimization.start();
+
+            // goal and environment final states of all tiers are the labels of the games
+            std::vector<CUDD::BDD> labels = env_final_states;
+            labels.push_back(symbolic_dfas_[0].final_states());
+            quotients_.push_back(BisimulationQuotient::minimize(arena_[0], labels));
+
+            std::cout << "DONE (" << minimization.stop().count() / 1000.0 << " s)" << std::endl;
+            std::cout << "\t[conj-MtSyft] arena minimized from " << quotients_[0].reachable_state_count() << " reachable states to " << quotients_[0].block_count() << " ("
+                      << var_mgr_->state_variable_count(quotients_[0].dfa().automaton_id()) << " state variables instead of " << var_mgr_->state_variable_count(arena_[0].automaton_id()) << ")" << std::endl;
+        } else {
+            quotients_.push_back(BisimulationQuotient::identity(arena_[0]));
+        }
+
+        std::cout << "[conj-MtSyft] constructing and solving games...";
+
+        // the adversarial games of all the tiers are on the same arena
+        auto adversarial_arena = std::make_shared<const GameArena>(quotients_[0].dfa());
+
+        TierSolver tier_solver(
+            var_mgr_,
+            tiers,
+            tier_solving_,
+            [this, &env_final_states, adversarial_arena](int i) { // adversarial game
+                if (!minimize_arenas_ && IndependentSubgameSynthesizer::subgame_detection()) {
+                    // goal or a violated env DFA of tier i, after the first move (final states of the tautology)
+                    std::vector<CUDD::BDD> goal_terms(symbolic_dfas_.size(), var_mgr_->cudd_mgr()->bddZero());
+                    goal_terms[0] = symbolic_dfas_[0].final_states();
+                    for (int j = i + 1; j < symbolic_dfas_.size() - 1; ++j) goal_terms[j] = !symbolic_dfas_[j].final_states();
+                    IndependentSubgameSynthesizer subgame_synthesizer(
+                        adversarial_arena,
+                        symbolic_dfas_,
+                        goal_terms,
+                        symbolic_dfas_.back().final_states(),
+                        starting_player_,
+                        Player::Agent);
+                    if (subgame_synthesizer.decomposable()) return subgame_synthesizer.run();
+                }
+
+                CUDD::BDD adv_goal = (!(env_final_states[i]) + symbolic_dfas_[0].final_states()) * !arena_[0].initial_state_bdd(); // adv agent goal
+                ReachabilitySynthesizer adversarial_synthesizer(
+                    adversarial_arena,
+                    starting_player_,
+                    Player::Agent,
+                    quotients_[0].to_quotient(adv_goal),
+                    var_mgr_->cudd_mgr()->bddOne()
+                );
+                return quotients_[0].from_quotient(adversarial_synthesizer.run());
+            },
+            [this, &env_final_states](int i) { // game on negated env DFA and cooperative game
+                // negated env game, solved on refinements i, ..., n-1 x base x tautology only
+                std::vector<std::string> environment(refinements_.begin() + i, refinements_.end());
+                environment.push_back(env_base_);
+                std::vector<SymbolicStateDfa> environment_dfas(symbolic_dfas_.begin() + i + 1, symbolic_dfas_.end() - 1);
+                CUDD::BDD non_environment_winning_region = environment_cache_->violation_region(
+                    environment,
+                    environment_dfas,
+                    starting_player_);
+                quotients_.push_back(quotients_[0].restriction(non_environment_winning_region));
+
+                CUDD::BDD cooperative_goal = env_final_states[i] * symbolic_dfas_[0].final_states();
+                CoOperativeReachabilitySynthesizer co_operative_synthesizer(
+                    quotients_.back().dfa(), // last added element is restricted arena
+                    starting_player_,
+                    Player::Agent,
+                    quotients_.back().to_quotient(cooperative_goal),
+                    var_mgr_->cudd_mgr()->bddOne()
+                );
+                return quotients_.back().from_quotient(co_operative_synthesizer.run());
+            },
+            true); // all tiers are on arena_[0]
+
         // adversarial games
-    
-        std::vector<double> t_adv_games;
-        CUDD::BDD env_final_states = var_mgr_->cudd_mgr()->bddOne();
-        for (int i = symbolic_dfas_.size()-2; i >= 1; --i) {
-            
-            Syft::Stopwatch adv_game;
-            adv_game.start();
-
-            env_final_states = env_final_states * symbolic_dfas_[i].final_states(); // construct env final states function
-            CUDD::BDD adv_goal = (!(env_final_states) + symbolic_dfas_[0].final_states()) * !arena_[0].initial_state_bdd(); // adv agent goal
-            // CUDD::BDD adv_goal = ((!env_final_states) + symbolic_dfas_[0].final_states()) * symbolic_dfas_[symbolic_dfas_.size() - 1].final_states();
-            // solve game
-            ReachabilitySynthesizer adversarial_synthesizer(
-                arena_[0],
-                starting_player_,
-                Player::Agent,
-                adv_goal,
-                var_mgr_->cudd_mgr()->bddOne()
-            );
-            
-            result.adversarial_results.push_back(adversarial_synthesizer.run());
+        std::vector<std::optional<double>> t_adv_games;
+        std::vector<SynthesisResult> adversarial_results = tier_solver.solve_adversarial_games(t_adv_games);
 
-            t_adv_games.push_back(adv_game.stop().count() / 1000.0); // note that these running times are from E_n -> \varphi to E_1 -> \varphi
-        }
         run_times_.push_back(adv_games.stop().count() / 1000.0);
 
         // cooperative games
         Syft::Stopwatch coop_games;
         coop_games.start();
 
-        std::vector<double> t_coop_games;
-        env_final_states = var_mgr_->cudd_mgr()->bddOne();
-        for (int i = symbolic_dfas_.size() - 2; i >= 1; --i) {
-            Syft::Stopwatch coop_game;
-            coop_game.start();
-
-            // game on negated env DFA
-
-            env_final_states = env_final_states * symbolic_dfas_[i].final_states(); // construct env final states function
-            CUDD::BDD negated_env_goal = !(env_final_states) * !arena_[0].initial_state_bdd();
-
-            ReachabilitySynthesizer negated_env_synthesizer(
-                arena_[0],
-                starting_player_,
-                Player::Agent,
-                negated_env_goal,
-                var_mgr_->cudd_mgr()->bddOne()
-            );
-            SynthesisResult enviroment_result = negated_env_synthesizer.run();
-            CUDD::BDD non_environment_winning_region = enviroment_result.winning_states;
-            arena_.push_back(arena_[0].get_restriction(non_environment_winning_region));
-
-            // cooperative game
-            CUDD::BDD cooperative_goal = env_final_states * symbolic_dfas_[0].final_states();
-
-            CoOperativeReachabilitySynthesizer co_operative_synthesizer(
-                arena_[arena_.size() - 1], // last added element is restricted arena
-                starting_player_,
-                Player::Agent,
-                cooperative_goal,
-                var_mgr_->cudd_mgr()->bddOne()
-            );
-            
-            result.cooperative_results.push_back(co_operative_synthesizer.run());
+        std::vector<std::optional<double>> t_coop_games;
+        std::vector<SynthesisResult> cooperative_results = tier_solver.solve_cooperative_games(adversarial_results, t_coop_games);
+
+        run_times_.push_back(coop_games.stop().count() / 1000.0);
 
-            t_coop_games.push_back(coop_game.stop().count() / 1000.0);
+        // results are stored from E_n to E_1
+        for (int i = tiers - 1; i >= 0; --i) {
+            result.adversarial_results.push_back(std::move(adversarial_results[i]));
+            result.cooperative_results.push_back(std::move(cooperative_results[i]));
         }
 
-        run_times_.push_back(coop_games.stop().count() / 1000.0);
         std::cout << "DONE (" << run_times_[2] + run_times_[3] << " s)"  << std::endl;
-        int j = 1;
-        for (int i = t_adv_games.size() - 1; i >= 0; --i) {
-            std::cout << "\t[conj-MtSyft] adv game in env " << j << " solved in " << t_adv_games[i] << " s" << std::endl;
-            ++j;
+        for (int i = 0; i < t_adv_games.size(); ++i) {
+            if (t_adv_games[i]) std::cout << "\t[conj-MtSyft] adv game in env " << i + 1 << " solved in " << *t_adv_games[i] << " s" << std::endl;
+            else std::cout << "\t[conj-MtSyft] adv game in env " << i + 1 << " decided by monotonicity" << std::endl;
         }
-        j = 1;
-        for (int i = t_coop_games.size() - 1; i >= 0; --i) {
-            std::cout <<  "\t[conj-MtSyft] coop game in env " << j << " solved in " << t_coop_games[i] << " s" << std::endl; 
-            ++j;
+        for (int i = 0; i < t_coop_games.size(); ++i) {
+            if (t_coop_games[i]) std::cout << "\t[conj-MtSyft] coop game in env " << i + 1 << " solved in " << *t_coop_games[i] << " s" << std::endl;
+            else std::cout << "\t[conj-MtSyft] coop game in env " << i + 1 << " not solved" << std::endl;
         }
-
-        return result;
     }
 
     void RefiningEnvironmentsChainSynthesizer::realizability(const std::vector<Syft::SynthesisResult>& adv_results, const std::vector<Syft::SynthesisResult>& coop_results) const {
@@ -286,6 +378,10 @@ namespace Syft {
 
     }
 
+    bool RefiningEnvironmentsChainSynthesizer::timed_out() const {
+        return timed_out_;
+    }
+
     std::vector<double> RefiningEnvironmentsChainSynthesizer::get_run_times() const {
         return run_times_;
     }
@@ -0,0 +1,165 @@
+#include "Simulator.h"
+
+#include <algorithm>
+
+namespace Syft {
+
+namespace {
+
+std::vector<int> variables_with_role(const VarMgr& var_mgr,
+                                     std::vector<VariableRole> roles) {
+  std::vector<int> variables;
+
+  for (std::size_t i = 0; i < var_mgr.total_variable_count(); ++i) {
+    VariableRole role = var_mgr.variable_info(i).role;
+    if (std::find(roles.begin(), roles.end(), role) != roles.end()) {
+      variables.push_back(i);
+    }
+  }
+
+  return variables;
+}
+
+std::vector<int> function_variables(
+    const std::unordered_map<int, CUDD::BDD>& functions) {
+  std::vector<int> variables;
+
+  for (const auto& [variable, function] : functions) {
+    variables.push_back(variable);
+  }
+  std::sort(variables.begin(), variables.end());
+
+  return variables;
+}
+
+std::vector<CUDD::BDD> functions_of(
+    const std::unordered_map<int, CUDD::BDD>& functions,
+    const std::vector<int>& variables) {
+  std::vector<CUDD::BDD> ordered;
+
+  for (int variable : variables) {
+    ordered.push_back(functions.at(variable));
+  }
+
+  return ordered;
+}
+
+}
+
+Simulator::Simulator(const VarMgr& var_mgr, std::size_t automaton_id,
+                     std::vector<int> initial_vector, std::size_t words)
+  : words_(std::max<std::size_t>(words, 1)),
+    initial_vector_(std::move(initial_vector)) {
+  std::size_t state_count = var_mgr.state_variable_count(automaton_id);
+
+  for (std::size_t i = 0; i < state_count; ++i) {
+    state_variables_.push_back(
+        var_mgr.state_variable(automaton_id, i).NodeReadIndex());
+  }
+
+  valuation_.resize(var_mgr.total_variable_count() * words_);
+  next_state_.resize(state_count * words_);
+  reset();
+}
+
+void Simulator::advance(const BatchEvaluator& transitions) {
+  transitions.evaluate(valuation_.data(), words_, next_state_.data());
+
+  for (std::size_t i = 0; i < state_variables_.size(); ++i) {
+    std::copy(next_state_.begin() + i * words_,
+              next_state_.begin() + (i + 1) * words_,
+              values(state_variables_[i]));
+  }
+}
+
+std::size_t Simulator::runs() const {
+  return 64 * words_;
+}
+
+std::size_t Simulator::words() const {
+  return words_;
+}
+
+void Simulator::reset() {
+  for (std::size_t i = 0; i < initial_vector_.size(); ++i) {
+    std::fill(values(i), values(i) + words_,
+              initial_vector_[i] ? ~std::uint64_t(0) : std::uint64_t(0));
+  }
+}
+
+std::uint64_t* Simulator::values(int variable) {
+  return valuation_.data() + variable * words_;
+}
+
+const std::uint64_t* Simulator::values(int variable) const {
+  return valuation_.data() + variable * words_;
+}
+
+void Simulator::randomize(const std::vector<int>& variables,
+                          std::mt19937_64& generator) {
+  for (int variable : variables) {
+    std::generate(values(variable), values(variable) + words_,
+                  std::ref(generator));
+  }
+}
+
+DfaSimulator::DfaSimulator(const SymbolicStateDfa& dfa, std::size_t words)
+  : Simulator(*dfa.var_mgr(), dfa.automaton_id(),
+              dfa.var_mgr()->make_eval_vector(dfa.automaton_id(),
+                                              dfa.initial_state()),
+              words),
+    letter_variables_(variables_with_role(
+        *dfa.var_mgr(),
+        {VariableRole::Named, VariableRole::Input, VariableRole::Output})),
+    transitions_(dfa.transition_function()),
+    final_states_({dfa.final_states()}) {}
+
+const std::vector<int>& DfaSimulator::letter_variables() const {
+  return letter_variables_;
+}
+
+void DfaSimulator::step() {
+  advance(transitions_);
+}
+
+std::vector<std::uint64_t> DfaSimulator::accepting() const {
+  std::vector<std::uint64_t> accepting(words_);
+  final_states_.evaluate(valuation_.data(), words_, accepting.data());
+
+  return accepting;
+}
+
+StrategySimulator::StrategySimulator(const Transducer& transducer,
+                                     std::size_t words)
+  : Simulator(*transducer.var_mgr_, transducer.automaton_id_,
+              transducer.initial_vector_, words),
+    protagonist_variables_(function_variables(transducer.output_function_)),
+    opponent_variables_(variables_with_role(
+        *transducer.var_mgr_,
+        {transducer.protagonist_player_ == Player::Agent ?
+         VariableRole::Input : VariableRole::Output})),
+    outputs_(functions_of(transducer.output_function_,
+                          protagonist_variables_)),
+    transitions_(transducer.transition_function_),
+    moves_(protagonist_variables_.size() * words_) {}
+
+const std::vector<int>& StrategySimulator::protagonist_variables() const {
+  return protagonist_variables_;
+}
+
+const std::vector<int>& StrategySimulator::opponent_variables() const {
+  return opponent_variables_;
+}
+
+void StrategySimulator::step() {
+  outputs_.evaluate(valuation_.data(), words_, moves_.data());
+
+  for (std::size_t i = 0; i < protagonist_variables_.size(); ++i) {
+    std::copy(moves_.begin() + i * words_, moves_.begin() + (i + 1) * words_,
+              values(protagonist_variables_[i]));
+  }
+
+  advance(transitions_);
+}
+
+}
@@ -1,7 +1,25 @@
 #include "SymbolicStateDfa.h"
 
+#include <unordered_set>
+
+#include "Profiler.h"
+
 namespace Syft {
 
+namespace {
+
+bool unused_codes_as_dont_cares = false;
+
+}
+
+void SymbolicStateDfa::set_dont_care_encoding(bool dont_cares) {
+  unused_codes_as_dont_cares = dont_cares;
+}
+
+bool SymbolicStateDfa::dont_care_encoding() {
+  return unused_codes_as_dont_cares;
+}
+
 SymbolicStateDfa::SymbolicStateDfa(std::shared_ptr<VarMgr> var_mgr)
   : var_mgr_(std::move(var_mgr))
 {}
@@ -77,6 +95,8 @@ std::vector<CUDD::BDD> SymbolicStateDfa::symbolic_transition_function(
       bit_count, var_mgr->cudd_mgr()->bddZero());
 
   for (std::size_t j = 0; j < transition_function.size(); ++j) {
+    var_mgr->check_deadline();
+
     CUDD::BDD state_bdd = state_to_bdd(var_mgr, automaton_id, j);
 
     for (std::size_t i = 0; i < bit_count; ++i) {
@@ -90,8 +110,48 @@ std::vector<CUDD::BDD> SymbolicStateDfa::symbolic_transition_function(
   return symbolic_transition_function;
 }
 
+CUDD::BDD SymbolicStateDfa::codes_below(
+    const std::shared_ptr<VarMgr>& var_mgr,
+    std::size_t automaton_id,
+    std::size_t state_count) {
+  std::size_t bit_count = var_mgr->state_variable_count(automaton_id);
+
+  if ((state_count >> bit_count) > 0) {
+    return var_mgr->cudd_mgr()->bddOne();
+  }
+
+  // Compares the codes with state_count from the least significant bit: a
+  // code is below if its highest bit that differs from state_count is 0
+  CUDD::BDD below = var_mgr->cudd_mgr()->bddZero();
+
+  for (std::size_t i = 0; i < bit_count; ++i) {
+    CUDD::BDD bit = var_mgr->state_variable(automaton_id, i);
+
+    if ((state_count >> i) & 1) {
+      below |= !bit;
+    } else {
+      below &= !bit;
+    }
+  }
+
+  return below;
+}
+
+void SymbolicStateDfa::restrict_to_valid_states() {
+  if (!unused_codes_as_dont_cares || valid_states_.IsOne()) {
+    return;
+  }
+
+  for (CUDD::BDD& bit_function : transition_function_) {
+    bit_function = bit_function.Restrict(valid_states_);
+  }
+  final_states_ = final_states_.Restrict(valid_states_);
+}
+
 SymbolicStateDfa SymbolicStateDfa::from_explicit(
     const ExplicitStateDfa& explicit_dfa) {
+  ProfileSpan span("symbolization", "dfa2symbolic");
+
   std::shared_ptr<VarMgr> var_mgr = explicit_dfa.var_mgr();
 
   auto count_and_id = create_state_variables(var_mgr,
@@ -113,6 +173,10 @@ SymbolicStateDfa SymbolicStateDfa::from_explicit(
   symbolic_dfa.initial_state_ = std::move(initial_state);
   symbolic_dfa.final_states_ = std::move(final_states);
   symbolic_dfa.transition_function_ = std::move(transition_function);
+  symbolic_dfa.valid_states_ = unused_codes_as_dont_cares ?
+    codes_below(var_mgr, automaton_id, explicit_dfa.state_count()) :
+    var_mgr->cudd_mgr()->bddOne();
+  symbolic_dfa.restrict_to_valid_states();
 
   return symbolic_dfa;
 }
@@ -125,7 +189,7 @@ std::size_t SymbolicStateDfa::automaton_id() const {
   return automaton_id_;
 }
   
-std::vector<int> SymbolicStateDfa::initial_state() const {
+const std::vector<int>& SymbolicStateDfa::initial_state() const {
   return initial_state_;
 }
 
@@ -134,14 +198,18 @@ CUDD::BDD SymbolicStateDfa::initial_state_bdd() const {
   return state_to_bdd(var_mgr_, automaton_id_, 0);
 }
 
-CUDD::BDD SymbolicStateDfa::final_states() const {
+const CUDD::BDD& SymbolicStateDfa::final_states() const {
   return final_states_;
 }
 
-std::vector<CUDD::BDD> SymbolicStateDfa::transition_function() const {
+const std::vector<CUDD::BDD>& SymbolicStateDfa::transition_function() const {
   return transition_function_;
 }
 
+const CUDD::BDD& SymbolicStateDfa::valid_states() const {
+  return valid_states_;
+}
+
 void SymbolicStateDfa::prune_invalid_states(const CUDD::BDD& invalid_states) {
   for (CUDD::BDD& bit_function : transition_function_) {
     // If the current state is an invalid state, send every transition to
@@ -173,6 +241,7 @@ SymbolicStateDfa SymbolicStateDfa::get_restriction(const CUDD::BDD& invalid_stat
   restricted_dfa.initial_state_ = initial_state;
   restricted_dfa.final_states_ = restriction_final_states;
   restricted_dfa.transition_function_ = restriction_transitions;
+  restricted_dfa.valid_states_ = valid_states_;
 
   return restricted_dfa;
 
@@ -213,11 +282,14 @@ SymbolicStateDfa SymbolicStateDfa::from_predicates(
   dfa.initial_state_ = std::move(initial_state);
   dfa.transition_function_ = std::move(predicates);
   dfa.final_states_ = std::move(final_states);
+  dfa.valid_states_ = dfa.var_mgr_->cudd_mgr()->bddOne();
 
   return dfa;
 }
 
 SymbolicStateDfa SymbolicStateDfa::product(const std::vector<SymbolicStateDfa>& dfa_vector) {
+    ProfileSpan span("product", "dfa2symbolic", "dfas", dfa_vector.size());
+
     if (dfa_vector.size() < 1) {
         throw std::runtime_error("Incorrect usage of automata product");
     }
@@ -229,17 +301,31 @@ SymbolicStateDfa SymbolicStateDfa::product(const std::vector<SymbolicStateDfa>&
     std::vector<int> initial_state;
 
     CUDD::BDD final_states = var_mgr->cudd_mgr()->bddOne();
+    CUDD::BDD valid_states = var_mgr->cudd_mgr()->bddOne();
     std::vector<CUDD::BDD> transition_function;
 
-    for (SymbolicStateDfa dfa : dfa_vector) {
+    // a state variable shared by several components, e.g., of the DFA of a
+    // conjunct common to two of them, has a single bit in the product, as in
+    // VarMgr::create_product_state_space
+    std::unordered_set<unsigned int> included_variables;
+
+    for (const SymbolicStateDfa& dfa : dfa_vector) {
+        var_mgr->check_deadline();
+
         automaton_ids.push_back(dfa.automaton_id());
 
-        std::vector<int> dfa_initial_state = dfa.initial_state();
-        initial_state.insert(initial_state.end(), dfa_initial_state.begin(), dfa_initial_state.end());
+        const std::vector<int>& dfa_initial_state = dfa.initial_state();
+        const std::vector<CUDD::BDD>& dfa_transition_function = dfa.transition_function();
+
+        for (std::size_t b = 0; b < dfa_transition_function.size(); ++b) {
+            if (included_variables.insert(var_mgr->state_variable(dfa.automaton_id(), b).NodeReadIndex()).second) {
+                initial_state.push_back(dfa_initial_state[b]);
+                transition_function.push_back(dfa_transition_function[b]);
+            }
+        }
 
         final_states = final_states & dfa.final_states();
-        std::vector<CUDD::BDD> dfa_transition_function = dfa.transition_function();
-        transition_function.insert(transition_function.end(), dfa_transition_function.begin(), dfa_transition_function.end());
+        valid_states = valid_states & dfa.valid_states();
     }
 
     std::size_t product_automaton_id = var_mgr->create_product_state_space(automaton_ids);
@@ -249,6 +335,7 @@ SymbolicStateDfa SymbolicStateDfa::product(const std::vector<SymbolicStateDfa>&
     product_automaton.initial_state_ = std::move(initial_state);
     product_automaton.final_states_ = std::move(final_states);
     product_automaton.transition_function_ = std::move(transition_function);
+    product_automaton.valid_states_ = std::move(valid_states);
 
     return product_automaton;
 }
@@ -271,6 +358,7 @@ SymbolicStateDfa SymbolicStateDfa::negation(const SymbolicStateDfa& dfa) {
   negated_dfa.initial_state_ = initial_state;
   negated_dfa.final_states_ = negated_final_states;
   negated_dfa.transition_function_ = transition_function;
+  negated_dfa.valid_states_ = dfa.valid_states();
 
   return negated_dfa;
 }
@@ -286,6 +374,23 @@ SymbolicStateDfa SymbolicStateDfa::from_bdds(std::shared_ptr<Syft::VarMgr> var_m
   dfa.initial_state_ = initial_state;
   dfa.final_states_ = final_states;
   dfa.transition_function_ = transition_function;
+  dfa.valid_states_ = var_mgr->cudd_mgr()->bddOne();
+  return dfa;
+}
+
+SymbolicStateDfa SymbolicStateDfa::from_bdds(std::shared_ptr<Syft::VarMgr> var_mgr,
+                                std::size_t automaton_id,
+                                std::vector<int> initial_state,
+                                CUDD::BDD final_states,
+                                std::vector<CUDD::BDD> transition_function,
+                                CUDD::BDD valid_states)
+{
+  SymbolicStateDfa dfa = from_bdds(std::move(var_mgr), automaton_id,
+                                   std::move(initial_state),
+                                   std::move(final_states),
+                                   std::move(transition_function));
+  dfa.valid_states_ = std::move(valid_states);
+  dfa.restrict_to_valid_states();
   return dfa;
 }
 
@@ -0,0 +1,27 @@
+#include "SynthesisMode.h"
+
+#include <stdexcept>
+
+namespace Syft {
+
+std::string to_string(SynthesisMode mode) {
+  switch (mode) {
+    case SynthesisMode::Chain:
+      return "mtsyft";
+    case SynthesisMode::CommonBase:
+      return "cb-mtsyft";
+    case SynthesisMode::Refinements:
+      return "conj-mtsyft";
+  }
+  throw std::runtime_error("Error: Unknown synthesis mode.");
+}
+
+SynthesisMode synthesis_mode_from_string(const std::string& name) {
+  if (name == "mtsyft") return SynthesisMode::Chain;
+  if (name == "cb-mtsyft") return SynthesisMode::CommonBase;
+  if (name == "conj-mtsyft") return SynthesisMode::Refinements;
+  throw std::runtime_error("Error: Unknown synthesis mode " + name +
+                           " (expected mtsyft, cb-mtsyft or conj-mtsyft).");
+}
+
+}
@@ -0,0 +1,148 @@
+#include "SynthesisSession.h"
+
+#include <stdexcept>
+
+#include "CommonCoreChainSynthesizer.h"
+#include "ConjunctiveDfa.h"
+#include "EnvironmentsChainBestEffortSynthesizer.h"
+#include "RefiningEnvironmentsChainSynthesizer.h"
+#include "Stopwatch.h"
+#include "SymbolicStateDfa.h"
+
+namespace Syft {
+
+std::string realizability_string(const ChainedStrategies& strategies) {
+  std::string result;
+
+  for (std::size_t i = 0; i < strategies.adversarial_results.size(); ++i) {
+    if (i > 0) {
+      result += ";";
+    }
+    if (strategies.adversarial_results[i].realizability) {
+      result += "A";
+    } else if (i < strategies.cooperative_results.size() &&
+               strategies.cooperative_results[i].realizability) {
+      result += "C";
+    } else {
+      result += "U";
+    }
+  }
+
+  return result;
+}
+
+SynthesisSession::SynthesisSession(std::vector<std::string> environment_specs,
+                                   InputOutputPartition partition,
+                                   Player starting_player,
+                                   SynthesisMode mode,
+                                   std::shared_ptr<VarMgr> var_mgr)
+  : var_mgr_(std::move(var_mgr)),
+    environment_specs_(std::move(environment_specs)),
+    partition_(std::move(partition)),
+    starting_player_(starting_player),
+    mode_(mode) {
+  if (environment_specs_.empty()) {
+    throw std::runtime_error("Error: No environment specification given.");
+  }
+
+  Stopwatch setup;
+  setup.start();
+
+  environment_cache_ = std::make_shared<EnvironmentCache>(var_mgr_);
+
+  // Goals may mention propositions that no tier does, so all the variables of
+  // the partition are created upfront
+  var_mgr_->create_named_variables(partition_.input_variables);
+  var_mgr_->create_named_variables(partition_.output_variables);
+
+  for (const std::string& spec : environment_specs_) {
+    var_mgr_->check_deadline();
+
+    if (environment_cache_->reuse_dfa(spec)) {
+      continue;
+    }
+
+    ConjunctiveDfa mona_dfa = ConjunctiveDfa::of_formula(spec);
+    var_mgr_->create_named_variables(mona_dfa.names());
+
+    environment_cache_->insert_dfa(spec, mona_dfa.to_symbolic(*environment_cache_));
+  }
+
+  environment_cache_->non_empty_traces_dfa();
+
+  var_mgr_->partition_variables(partition_.input_variables,
+                                partition_.output_variables);
+
+  setup_time_ = setup.stop().count() / 1000.0;
+}
+
+void SynthesisSession::set_tier_solving(TierSolving tier_solving) {
+  tier_solving_ = tier_solving;
+}
+
+void SynthesisSession::set_arena_minimization(bool minimize_arenas) {
+  minimize_arenas_ = minimize_arenas;
+}
+
+std::shared_ptr<VarMgr> SynthesisSession::var_mgr() const {
+  return var_mgr_;
+}
+
+const EnvironmentCache& SynthesisSession::environment_cache() const {
+  return *environment_cache_;
+}
+
+double SynthesisSession::setup_time() const {
+  return setup_time_;
+}
+
+GoalResult SynthesisSession::synthesize(const std::string& goal) {
+  GoalResult result;
+  result.goal = goal;
+
+  Stopwatch timer;
+  timer.start();
+
+  const std::vector<std::string>& specs = environment_specs_;
+
+  switch (mode_) {
+    case SynthesisMode::Chain: {
+      EnvironmentsChainBestEffortSynthesizer synthesizer(
+          var_mgr_, goal, specs, partition_, starting_player_,
+          environment_cache_);
+      synthesizer.set_tier_solving(tier_solving_);
+      synthesizer.set_arena_minimization(minimize_arenas_);
+      result.strategies = synthesizer.run();
+      result.run_times = synthesizer.get_run_times();
+      break;
+    }
+    case SynthesisMode::CommonBase: {
+      CommonCoreChainSynthesizer synthesizer(
+          var_mgr_, goal, specs.front(),
+          std::vector<std::string>(specs.begin() + 1, specs.end()),
+          partition_, starting_player_, environment_cache_);
+      synthesizer.set_tier_solving(tier_solving_);
+      synthesizer.set_arena_minimization(minimize_arenas_);
+      result.strategies = synthesizer.run();
+      result.run_times = synthesizer.get_run_times();
+      break;
+    }
+    case SynthesisMode::Refinements: {
+      RefiningEnvironmentsChainSynthesizer synthesizer(
+          var_mgr_, goal,
+          std::vector<std::string>(specs.begin(), specs.end() - 1),
+          specs.back(), partition_, starting_player_, environment_cache_);
+      synthesizer.set_tier_solving(tier_solving_);
+      synthesizer.set_arena_minimization(minimize_arenas_);
+      result.strategies = synthesizer.run();
+      result.run_times = synthesizer.get_run_times();
+      break;
+    }
+  }
+
+  result.running_time = timer.stop().count() / 1000.0;
+
+  return result;
+}
+
+}
@@ -0,0 +1,127 @@
+#include "TierMap.h"
+
+#include <cmath>
+
+namespace Syft {
+
+TierMap::TierMap(std::shared_ptr<VarMgr> var_mgr,
+                 const std::vector<SynthesisResult>& adversarial_results,
+                 const std::vector<SynthesisResult>& cooperative_results)
+  : var_mgr_(std::move(var_mgr)),
+    tier_count_(adversarial_results.size()) {
+  std::shared_ptr<CUDD::Cudd> mgr = var_mgr_->cudd_mgr();
+
+  // Region where tier i is the greatest one won adversarially, and where it
+  // is the least one won cooperatively
+  std::vector<CUDD::BDD> adversarial_regions(tier_count_);
+  std::vector<CUDD::BDD> cooperative_regions(tier_count_);
+  CUDD::BDD won_above = mgr->bddZero();
+  CUDD::BDD won_below = mgr->bddZero();
+
+  for (int i = tier_count_ - 1; i >= 0; --i) {
+    adversarial_regions[i] = adversarial_results[i].winning_states & !won_above;
+    won_above |= adversarial_results[i].winning_states;
+  }
+
+  for (int i = 0; i < tier_count_; ++i) {
+    cooperative_regions[i] = cooperative_results[i].winning_states & !won_below;
+    won_below |= cooperative_results[i].winning_states;
+  }
+
+  // Tiers are stored shifted by one, so that 0 means none
+  CUDD::ADD max_win = mgr->addZero();
+  CUDD::ADD min_coop = mgr->addZero();
+  CUDD::ADD min_coop_above = mgr->addZero();
+
+  for (int i = 0; i < tier_count_; ++i) {
+    max_win = adversarial_regions[i].Add().Ite(mgr->constant(i + 1), max_win);
+  }
+
+  for (int i = tier_count_ - 1; i >= 0; --i) {
+    min_coop = cooperative_regions[i].Add().Ite(mgr->constant(i + 1), min_coop);
+  }
+
+  // Where max_win is m, the least tier above m won cooperatively
+  CUDD::BDD no_win = !won_above;
+  for (int m = -1; m < tier_count_; ++m) {
+    var_mgr_->check_deadline();
+
+    CUDD::ADD least_above = mgr->addZero();
+    for (int i = tier_count_ - 1; i > m; --i) {
+      least_above = cooperative_results[i].winning_states.Add().Ite(
+          mgr->constant(i + 1), least_above);
+    }
+
+    CUDD::BDD region = m < 0 ? no_win : adversarial_regions[m];
+    min_coop_above = region.Add().Ite(least_above, min_coop_above);
+  }
+
+  CUDD::ADD base = mgr->constant(tier_count_ + 1);
+  tiers_ = (max_win * base + min_coop_above) * base + min_coop;
+
+  adversarial_output_function_ =
+    merge_output_functions(adversarial_results, adversarial_regions);
+  cooperative_output_function_ =
+    merge_output_functions(cooperative_results, cooperative_regions);
+}
+
+std::unordered_map<int, CUDD::BDD> TierMap::merge_output_functions(
+    const std::vector<SynthesisResult>& results,
+    const std::vector<CUDD::BDD>& regions) {
+  std::unordered_map<int, CUDD::BDD> merged;
+
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    // Tiers decided unrealizable without solving their game have none
+    if (!results[i].transducer) {
+      continue;
+    }
+
+    const std::unordered_map<int, CUDD::BDD>& output_function =
+      results[i].transducer->get_output_function();
+
+    for (const auto& [index, function] : output_function) {
+      auto it = merged.find(index);
+
+      if (it == merged.end()) {
+        merged.emplace(index, regions[i] & function);
+      } else {
+        it->second |= regions[i] & function;
+      }
+    }
+  }
+
+  return merged;
+}
+
+TierSelection TierMap::select(const std::vector<int>& state,
+                              int least_valid_tier) const {
+  CUDD::ADD leaf = tiers_.Eval(const_cast<int*>(state.data()));
+  long value = std::lround(Cudd_V(leaf.getNode()));
+
+  long base = tier_count_ + 1;
+  int min_coop = value % base - 1;
+  int min_coop_above = (value / base) % base - 1;
+  int max_win = value / (base * base) - 1;
+
+  TierSelection selection;
+
+  if (max_win >= least_valid_tier) {
+    selection.max_win = max_win;
+    selection.min_coop = min_coop_above;
+  } else {
+    selection.min_coop = min_coop;
+  }
+
+  return selection;
+}
+
+const std::unordered_map<int, CUDD::BDD>& TierMap::output_function(
+    const TierSelection& selection) const {
+  if (selection.max_win >= 0) {
+    return adversarial_output_function_;
+  }
+
+  return cooperative_output_function_;
+}
+
+}
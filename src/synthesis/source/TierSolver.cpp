@@ -0,0 +1,198 @@
+#include "TierSolver.h"
+
+#include <stdexcept>
+
+#include "Profiler.h"
+#include "Stopwatch.h"
+#include "Transducer.h"
+
+namespace Syft {
+
+std::string to_string(TierSolving solving) {
+  switch (solving) {
+    case TierSolving::All:
+      return "all";
+    case TierSolving::SkipRealizable:
+      return "skip";
+    case TierSolving::Frontier:
+      return "frontier";
+  }
+
+  return "";
+}
+
+TierSolving tier_solving_from_string(const std::string& name) {
+  if (name == "all") {
+    return TierSolving::All;
+  } else if (name == "skip") {
+    return TierSolving::SkipRealizable;
+  } else if (name == "frontier") {
+    return TierSolving::Frontier;
+  }
+
+  throw std::runtime_error("Error: Unknown tier solving mode " + name + ".");
+}
+
+TierSolver::TierSolver(std::shared_ptr<VarMgr> var_mgr,
+                       int tier_count,
+                       TierSolving solving,
+                       Game adversarial_game,
+                       Game cooperative_game,
+                       bool shared_arena)
+  : var_mgr_(std::move(var_mgr)),
+    tier_count_(tier_count),
+    solving_(solving),
+    adversarial_game_(std::move(adversarial_game)),
+    cooperative_game_(std::move(cooperative_game)),
+    shared_arena_(shared_arena) {}
+
+SynthesisResult TierSolver::solve(
+    const char* name,
+    const Game& game,
+    int tier,
+    std::vector<std::optional<double>>& times) const {
+  ProfileSpan span(name, "tiers", "tier", tier + 1);
+
+  Stopwatch stopwatch;
+  stopwatch.start();
+
+  SynthesisResult result = game(tier);
+  times[tier] = stopwatch.stop().count() / 1000.0;
+
+  return result;
+}
+
+SynthesisResult TierSolver::without_strategy(bool realizability) const {
+  SynthesisResult result;
+  result.realizability = realizability;
+  result.winning_states = var_mgr_->cudd_mgr()->bddZero();
+
+  return result;
+}
+
+SynthesisResult TierSolver::inferred_from(const SynthesisResult& result) const {
+  // The region and strategy of another tier are on the state variables of
+  // its own arena, unless all tiers share one
+  if (!shared_arena_) {
+    return without_strategy(result.realizability);
+  }
+
+  SynthesisResult copied;
+  copied.realizability = result.realizability;
+  copied.winning_states = result.winning_states;
+
+  if (result.transducer) {
+    copied.transducer = std::make_unique<Transducer>(*result.transducer);
+  }
+
+  return copied;
+}
+
+std::vector<SynthesisResult> TierSolver::solve_adversarial_games(
+    std::vector<std::optional<double>>& times) const {
+  std::vector<SynthesisResult> results(tier_count_);
+  times.assign(tier_count_, std::nullopt);
+
+  if (solving_ != TierSolving::Frontier) {
+    for (int i = 0; i < tier_count_; ++i) {
+      results[i] = solve("adversarial game", adversarial_game_, i, times);
+    }
+
+    return results;
+  }
+
+  // Tiers below low are realizable, tiers from high on are not
+  int low = 0;
+  int high = tier_count_;
+
+  while (low < high) {
+    int middle = low + (high - low) / 2;
+    results[middle] =
+      solve("adversarial game", adversarial_game_, middle, times);
+
+    if (results[middle].realizability) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+
+  // Tier low - 1, if any, has been solved, and its strategy also wins under
+  // the more determined tiers
+  for (int i = low - 2; i >= 0; --i) {
+    if (!times[i]) {
+      results[i] = inferred_from(results[i + 1]);
+    }
+  }
+
+  for (int i = low; i < tier_count_; ++i) {
+    if (!times[i]) {
+      results[i] = without_strategy(false);
+    }
+  }
+
+  return results;
+}
+
+std::vector<SynthesisResult> TierSolver::solve_cooperative_games(
+    const std::vector<SynthesisResult>& adversarial_results,
+    std::vector<std::optional<double>>& times) const {
+  std::vector<SynthesisResult> results(tier_count_);
+  times.assign(tier_count_, std::nullopt);
+
+  // Tiers whose cooperative game has to be solved
+  std::vector<int> open;
+
+  for (int i = 0; i < tier_count_; ++i) {
+    if (solving_ != TierSolving::All && adversarial_results[i].realizability) {
+      // Not needed for the realizability, and the adversarial strategy may
+      // win by violating the environment
+      results[i] = without_strategy(false);
+    } else {
+      open.push_back(i);
+    }
+  }
+
+  if (solving_ != TierSolving::Frontier) {
+    for (int i : open) {
+      results[i] = solve("cooperative game", cooperative_game_, i, times);
+    }
+
+    return results;
+  }
+
+  // Open tiers below low are not cooperatively realizable, those from high
+  // on are
+  std::size_t low = 0;
+  std::size_t high = open.size();
+
+  while (low < high) {
+    std::size_t middle = low + (high - low) / 2;
+    results[open[middle]] =
+      solve("cooperative game", cooperative_game_, open[middle], times);
+
+    if (results[open[middle]].realizability) {
+      high = middle;
+    } else {
+      low = middle + 1;
+    }
+  }
+
+  for (std::size_t j = 0; j < low; ++j) {
+    if (!times[open[j]]) {
+      results[open[j]] = without_strategy(false);
+    }
+  }
+
+  // Open tier low, if any, has been solved, and its strategy is also
+  // cooperative under the less determined tiers
+  for (std::size_t j = low + 1; j < open.size(); ++j) {
+    if (!times[open[j]]) {
+      results[open[j]] = inferred_from(results[open[j - 1]]);
+    }
+  }
+
+  return results;
+}
+
+}
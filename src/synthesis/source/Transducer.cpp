@@ -9,12 +9,14 @@ Transducer::Transducer(std::shared_ptr<VarMgr> var_mgr,
                        std::vector<int> initial_vector,
                        std::unordered_map<int, CUDD::BDD> output_function,
                        std::vector<CUDD::BDD> transition_function,
+                       std::size_t automaton_id,
                        Player starting_player,
                        Player protagonist_player)
     : var_mgr_(std::move(var_mgr))
     , initial_vector_(std::move(initial_vector))
     , output_function_(std::move(output_function))
     , transition_function_(std::move(transition_function))
+    , automaton_id_(automaton_id)
     , starting_player_(starting_player)
     , protagonist_player_(protagonist_player)
 {}
@@ -40,7 +42,7 @@ void Transducer::dump_dot(const std::string& filename) const {
   var_mgr_->dump_dot(output_vector, output_labels, filename);
   }
 
-  std::unordered_map<int, CUDD::BDD> Transducer::get_output_function() const {
+  const std::unordered_map<int, CUDD::BDD>& Transducer::get_output_function() const {
     return output_function_;
   }
 }
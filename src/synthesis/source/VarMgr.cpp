@@ -5,6 +5,7 @@
 #include <boost/algorithm/string.hpp>
 #include <iostream>
 #include <algorithm>
+#include <unordered_set>
 
 namespace Syft {
 
@@ -12,19 +13,33 @@ VarMgr::VarMgr() {
   mgr_ = std::make_shared<CUDD::Cudd>();
 }
 
-std::unordered_map<int, std::string> VarMgr::get_index_to_name() const {
+const std::unordered_map<int, std::string>& VarMgr::get_index_to_name() const {
   return index_to_name_;
 }
 
-std::unordered_map<std::string, CUDD::BDD> VarMgr::get_name_to_variable() const {
+const std::unordered_map<std::string, CUDD::BDD>& VarMgr::get_name_to_variable() const {
   return name_to_variable_;
 }
 
+const VariableInfo& VarMgr::variable_info(int index) const {
+  return variable_info_.at(index);
+}
+
+std::size_t VarMgr::named_variable_count() const {
+  return named_variable_count_;
+}
+
+void VarMgr::set_variable_info(int index, const VariableInfo& info) {
+  if (index >= static_cast<int>(variable_info_.size())) {
+    variable_info_.resize(index + 1);
+  }
+
+  variable_info_[index] = info;
+}
+
 bool VarMgr::is_input_variable(const std::string& var) const {
-  CUDD::BDD bdd_var = name_to_variable_.at(var);
-  if (std::find(input_variables_.begin(), input_variables_.end(), bdd_var) != input_variables_.end())
-    return true;
-  return false;
+  int index = name_to_variable_.at(var).NodeReadIndex();
+  return variable_info(index).role == VariableRole::Input;
 }
 
 bool VarMgr::is_output_variable(const std::string& var) const {
@@ -53,6 +68,10 @@ void VarMgr::create_named_variables(
       int new_index = new_variable.NodeReadIndex();
       name_to_variable_[name] = new_variable;
       index_to_name_[new_index] = name;
+
+      VariableInfo info;
+      info.name_id = named_variable_count_++;
+      set_variable_info(new_index, info);
     } else {
       // std::cout << "Variable exists... next variable" << std::endl;
     }
@@ -73,6 +92,12 @@ std::size_t VarMgr::create_state_variables(std::size_t variable_count) {
     CUDD::BDD new_state_variable = mgr_->bddNewVarAtLevel(0);
     
     state_variables_[automaton_id].push_back(new_state_variable);
+
+    VariableInfo info;
+    info.role = VariableRole::State;
+    info.automaton_id = automaton_id;
+    info.bit = i;
+    set_variable_info(new_state_variable.NodeReadIndex(), info);
   }
 
   state_variable_count_ += variable_count;
@@ -80,17 +105,33 @@ std::size_t VarMgr::create_state_variables(std::size_t variable_count) {
   return automaton_id;
 }
 
+std::vector<CUDD::BDD> VarMgr::scratch_variables(std::size_t variable_count) {
+  if (scratch_variables_.size() < variable_count) {
+    std::size_t automaton_id =
+      create_state_variables(variable_count - scratch_variables_.size());
+    scratch_variables_.insert(scratch_variables_.end(),
+                              state_variables_[automaton_id].begin(),
+                              state_variables_[automaton_id].end());
+  }
+
+  return std::vector<CUDD::BDD>(scratch_variables_.begin(),
+                                scratch_variables_.begin() + variable_count);
+}
+
 std::size_t VarMgr::create_product_state_space(
     const std::vector<std::size_t>& automaton_ids) {
   std::size_t product_automaton_id = state_variables_.size();
 
   state_variables_.emplace_back();
 
+  std::unordered_set<unsigned int> included;  // by variable index
+
   for (std::size_t automaton_id : automaton_ids) {
-    state_variables_[product_automaton_id].insert(
-	state_variables_[product_automaton_id].end(),
-	state_variables_[automaton_id].begin(),
-	state_variables_[automaton_id].end());
+    for (const CUDD::BDD& variable : state_variables_[automaton_id]) {
+      if (included.insert(variable.NodeReadIndex()).second) {
+	state_variables_[product_automaton_id].push_back(variable);
+      }
+    }
   }
 
   return product_automaton_id;
@@ -102,7 +143,7 @@ CUDD::BDD VarMgr::state_variable(std::size_t automaton_id, std::size_t i)
 }
   
 CUDD::BDD VarMgr::state_vector_to_bdd(std::size_t automaton_id,
-				      const std::vector<int>& state_vector)
+                                      const std::vector<int>& state_vector)
     const {
   CUDD::BDD bdd = mgr_->bddOne();
   
@@ -118,8 +159,31 @@ CUDD::BDD VarMgr::state_vector_to_bdd(std::size_t automaton_id,
 }
 
 void VarMgr::partition_variables(const std::vector<std::string>& input_names,
-				 const std::vector<std::string>& output_names) {
+                                 const std::vector<std::string>& output_names) {
   if (!input_variables_.empty() || !output_variables_.empty()) {
+    auto same_variables = [this](const std::vector<std::string>& names,
+                                 const std::vector<CUDD::BDD>& variables) {
+      if (names.size() != variables.size()) {
+        return false;
+      }
+
+      for (std::size_t i = 0; i < names.size(); ++i) {
+        auto it = name_to_variable_.find(names[i]);
+
+        if (it == name_to_variable_.end() || it->second != variables[i]) {
+          return false;
+        }
+      }
+
+      return true;
+    };
+
+    if (input_names.size() + output_names.size() == index_to_name_.size() &&
+        same_variables(input_names, input_variables_) &&
+        same_variables(output_names, output_variables_)) {
+      return;
+    }
+
     throw std::runtime_error(
 	"Error: Only one input-output partition is allowed.");
   }
@@ -136,10 +200,18 @@ void VarMgr::partition_variables(const std::vector<std::string>& input_names,
   
   for (const std::string& input_name : input_names) {
     input_variables_.push_back(name_to_variable(input_name));
+
+    int index = input_variables_.back().NodeReadIndex();
+    variable_info_[index].role = VariableRole::Input;
+    variable_info_[index].bit = input_variables_.size() - 1;
   }
 
   for (const std::string& output_name : output_names) {
     output_variables_.push_back(name_to_variable(output_name));
+
+    int index = output_variables_.back().NodeReadIndex();
+    variable_info_[index].role = VariableRole::Output;
+    variable_info_[index].bit = output_variables_.size() - 1;
   }
 }
 
@@ -147,11 +219,46 @@ std::shared_ptr<CUDD::Cudd> VarMgr::cudd_mgr() const {
   return mgr_;
 }
 
+void VarMgr::set_deadline(std::shared_ptr<Deadline> deadline) {
+  deadline_ = std::move(deadline);
+
+  if (deadline_) {
+    mgr_->RegisterTerminationCallback(&Deadline::termination_callback,
+                                      deadline_.get());
+    mgr_->setTerminationHandler(&Deadline::termination_handler);
+  } else {
+    mgr_->UnregisterTerminationCallback();
+  }
+}
+
+std::shared_ptr<Deadline> VarMgr::deadline() const {
+  return deadline_;
+}
+
+void VarMgr::check_deadline() const {
+  if (deadline_) {
+    deadline_->check();
+  }
+}
+
+void VarMgr::set_bdd_backend(BddBackendKind backend) {
+  if (!bdd_backend_available(backend)) {
+    throw std::runtime_error("Error: BDD backend " + to_string(backend) +
+                             " is not available in this build.");
+  }
+
+  bdd_backend_ = backend;
+}
+
+BddBackendKind VarMgr::bdd_backend() const {
+  return bdd_backend_;
+}
+
 CUDD::BDD VarMgr::name_to_variable(const std::string& name) const {
   return name_to_variable_.at(name);
 }
 
-std::string VarMgr::index_to_name(int index) const {
+const std::string& VarMgr::index_to_name(int index) const {
   return index_to_name_.at(index);
 }
 
@@ -203,7 +310,7 @@ std::vector<int> VarMgr::make_eval_vector(
 std::vector<CUDD::BDD> VarMgr::make_compose_vector(
     std::size_t automaton_id, const std::vector<CUDD::BDD>& state_bdds) const {
   std::vector<CUDD::BDD> compose_vector(total_variable_count(),
-					mgr_->bddZero());
+                                	mgr_->bddZero());
 
   // All named variables get mapped to the variable itself
   for (const auto& name_and_variable : name_to_variable_) {